@@ -19,6 +19,13 @@ endif()
 
 file(MAKE_DIRECTORY ${PLUGIN_RUNTIME_DIRECTORY})
 
+# Installed plugins find the shared common library in CMAKE_INSTALL_LIBDIR and each other in
+# PLUGIN_PATH, relative to their own location
+file(RELATIVE_PATH PLUGIN_TO_LIBDIR ${CMAKE_INSTALL_PREFIX}/${PLUGIN_PATH}
+     ${CMAKE_INSTALL_PREFIX}/${CMAKE_INSTALL_LIBDIR})
+set(PLUGIN_INSTALL_RPATH "$ORIGIN" "$ORIGIN/${PLUGIN_TO_LIBDIR}")
+message(DEBUG "PLUGIN_INSTALL_RPATH: ${PLUGIN_INSTALL_RPATH}")
+
 # -----------------------------------------------------------------------------
 # Dependencies
 # -----------------------------------------------------------------------------
@@ -23,8 +23,13 @@
 #include "channel_access_client_variable.h"
 #include "channel_access_helper.h"
 
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/plugin_diagnostics.h>
+#include <oac-tree/common/trace.h>
+
 #include <sup/oac-tree/concrete_constraints.h>
 #include <sup/oac-tree/exceptions.h>
+#include <sup/oac-tree/generic_utils.h>
 #include <sup/oac-tree/variable_registry.h>
 #include <sup/oac-tree/workspace.h>
 
@@ -44,33 +49,66 @@ const std::string TYPE_ATTRIBUTE_NAME = "type";
 
 ChannelAccessClientVariable::ChannelAccessClientVariable()
   : Variable(ChannelAccessClientVariable::Type)
+  , m_mode{epics_helper::ClientMode::kMonitor}
   , m_anytype{}
+  , m_monitor_mask{channel_access_helper::MONITOR_MASK_DEFAULT}
+  , m_range{0, 0}
+  , m_range_mtx{}
+  , m_range_update{}
+  , m_last_update{}
+  , m_payload_size{0}
+  , m_statistics{}
+  , m_latency_file{}
+  , m_latency{}
+  , m_connection{}
+  , m_monitored{}
   , m_pv{}
 {
   (void)AddAttributeDefinition(CHANNEL_ATTRIBUTE_NAME, sup::dto::StringType).SetMandatory();
-  (void)AddAttributeDefinition(TYPE_ATTRIBUTE_NAME, sup::dto::StringType).SetMandatory();
+  (void)AddAttributeDefinition(TYPE_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(channel_access_helper::MONITOR_MASK_ATTRIBUTE_NAME,
+                               sup::dto::StringType);
+  (void)AddAttributeDefinition(channel_access_helper::OFFSET_ATTRIBUTE_NAME,
+                               sup::dto::UnsignedInteger64Type);
+  (void)AddAttributeDefinition(channel_access_helper::COUNT_ATTRIBUTE_NAME,
+                               sup::dto::UnsignedInteger64Type);
+  (void)AddAttributeDefinition(epics_helper::LATENCY_FILE_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(epics_helper::CONNECT_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(epics_helper::CONNECT_PRIORITY_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(epics_helper::MODE_ATTRIBUTE_NAME, sup::dto::StringType);
 }
 
 ChannelAccessClientVariable::~ChannelAccessClientVariable() = default;
 
 bool ChannelAccessClientVariable::GetValueImpl(sup::dto::AnyValue &value) const
 {
-  if (!m_pv)
+  if (m_mode == epics_helper::ClientMode::kConnection)
+  {
+    auto pv = m_pv.Get();
+    sup::dto::AnyValue connected{pv != nullptr && pv->IsConnected()};
+    return epics_helper::MoveOrAssign(value, std::move(connected));
+  }
+  auto pv = m_pv.GetConnected(epics_helper::FIRST_ACCESS_TIMEOUT_SEC);
+  if (pv == nullptr)
   {
     return false;
   }
-  auto ext_value = m_pv->GetExtendedValue();
-  auto result = channel_access_helper::ConvertToTypedAnyValue(ext_value, m_anytype);
+  auto result = channel_access_helper::ConvertToTypedAnyValue(GetChannelValue(*pv), m_anytype);
   if (sup::dto::IsEmptyValue(result))
   {
     return false;
   }
-  return sup::dto::TryAssign(value, result);
+  return epics_helper::MoveOrAssign(value, std::move(result));
 }
 
 bool ChannelAccessClientVariable::SetValueImpl(const sup::dto::AnyValue &value)
 {
-  if (!m_pv || !m_pv->IsConnected())
+  if (m_mode == epics_helper::ClientMode::kConnection)
+  {
+    return false;
+  }
+  auto pv = m_pv.GetConnected(epics_helper::FIRST_ACCESS_TIMEOUT_SEC);
+  if (pv == nullptr || !pv->IsConnected())
   {
     return false;
   }
@@ -80,23 +118,288 @@ bool ChannelAccessClientVariable::SetValueImpl(const sup::dto::AnyValue &value)
     {
       return false;
     }
-    return m_pv->SetValue(value[channel_access_helper::VALUE_FIELD_NAME]);
+    return pv->SetValue(value[channel_access_helper::VALUE_FIELD_NAME]);
   }
-  return m_pv->SetValue(value);
+  return pv->SetValue(value);
 }
 
 bool ChannelAccessClientVariable::IsAvailableImpl() const
 {
-  if (!m_pv || !m_pv->IsConnected())
+  if (m_mode == epics_helper::ClientMode::kConnection)
+  {
+    // The connection state is always known, but the first access still creates a lazy channel
+    (void)m_pv.Get();
+    return true;
+  }
+  auto pv = m_pv.GetConnected(epics_helper::FIRST_ACCESS_TIMEOUT_SEC);
+  if (pv == nullptr || !pv->IsConnected())
   {
     return false;
   }
-  auto ext_value = m_pv->GetExtendedValue();
+  auto ext_value = GetChannelValue(*pv);
   return !sup::dto::IsEmptyValue(ext_value.value);
 }
 
 SetupTeardownActions ChannelAccessClientVariable::SetupImpl(const Workspace& ws)
 {
+  if (HasAttribute(epics_helper::MODE_ATTRIBUTE_NAME))
+  {
+    auto mode_attr_val = GetAttributeString(epics_helper::MODE_ATTRIBUTE_NAME);
+    if (!epics_helper::ParseClientMode(mode_attr_val, m_mode))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + epics_helper::MODE_ATTRIBUTE_NAME +
+        "] with value [" + mode_attr_val + "]";
+      throw VariableSetupException(error_message);
+    }
+    if (m_mode == epics_helper::ClientMode::kGet)
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "attribute [" + epics_helper::MODE_ATTRIBUTE_NAME + "] with value [" + mode_attr_val +
+        "] is not supported";
+      throw VariableSetupException(error_message);
+    }
+  }
+  sup::dto::AnyType channel_type;
+  if (m_mode == epics_helper::ClientMode::kConnection)
+  {
+    // Request the smallest scalar payload (DBR_CHAR): its value is never used
+    m_anytype = sup::dto::BooleanType;
+    channel_type = sup::dto::UnsignedInteger8Type;
+  }
+  else
+  {
+    channel_type = SetupChannelType(ws);
+  }
+  m_monitor_mask = channel_access_helper::MONITOR_MASK_DEFAULT;
+  if (HasAttribute(channel_access_helper::MONITOR_MASK_ATTRIBUTE_NAME))
+  {
+    auto mask_attr_val = GetAttributeString(channel_access_helper::MONITOR_MASK_ATTRIBUTE_NAME);
+    if (!channel_access_helper::ParseMonitorMask(mask_attr_val, m_monitor_mask))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + channel_access_helper::MONITOR_MASK_ATTRIBUTE_NAME +
+        "] with value [" + mask_attr_val + "]";
+      throw VariableSetupException(error_message);
+    }
+    // Filtering on value changes keeps a copy of the last value for comparison: only cheap for
+    // scalar channels
+    if ((m_monitor_mask & channel_access_helper::MONITOR_MASK_DEFAULT) ==
+          channel_access_helper::MONITOR_MASK_VALUE && sup::dto::IsArrayType(channel_type))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "attribute [" + channel_access_helper::MONITOR_MASK_ATTRIBUTE_NAME + "] with value [" +
+        mask_attr_val + "] is only supported for scalar channels";
+      throw VariableSetupException(error_message);
+    }
+  }
+  bool lazy = false;
+  if (HasAttribute(epics_helper::CONNECT_ATTRIBUTE_NAME))
+  {
+    auto connect_attr_val = GetAttributeString(epics_helper::CONNECT_ATTRIBUTE_NAME);
+    if (!epics_helper::ParseConnectMode(connect_attr_val, lazy))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + epics_helper::CONNECT_ATTRIBUTE_NAME +
+        "] with value [" + connect_attr_val + "]";
+      throw VariableSetupException(error_message);
+    }
+  }
+  sup::dto::int32 priority = 0;
+  if (HasAttribute(epics_helper::CONNECT_PRIORITY_ATTRIBUTE_NAME))
+  {
+    auto priority_attr_val = GetAttributeString(epics_helper::CONNECT_PRIORITY_ATTRIBUTE_NAME);
+    if (!epics_helper::ParseConnectPriority(priority_attr_val, priority))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + epics_helper::CONNECT_PRIORITY_ATTRIBUTE_NAME +
+        "] with value [" + priority_attr_val + "]";
+      throw VariableSetupException(error_message);
+    }
+  }
+  m_payload_size = epics_helper::FixedPayloadSize(channel_type);
+  auto channel = GetAttributeString(CHANNEL_ATTRIBUTE_NAME);
+  m_statistics = epics_helper::CreateVariableStatistics(ChannelAccessClientVariable::Type, channel);
+  if (HasAttribute(epics_helper::LATENCY_FILE_ATTRIBUTE_NAME))
+  {
+    m_latency_file = GetAttributeString(epics_helper::LATENCY_FILE_ATTRIBUTE_NAME);
+    m_latency = epics_helper::CreateChannelLatency(ChannelAccessClientVariable::Type, channel);
+  }
+  auto callback =
+    [this](const epics::ChannelAccessPV::ExtendedValue& ext_value) {
+      epics_helper::ActiveCallbackGuard callback_guard;
+      epics_helper::TraceSpan callback_span{"ChannelAccessClient.monitor"};
+      if (m_mode == epics_helper::ClientMode::kConnection)
+      {
+        HandleConnectionUpdate(ext_value.connected);
+        return;
+      }
+      auto receipt_time = m_latency ? epics_helper::LatencyClock() : 0;
+      if (m_range.count != 0)
+      {
+        HandleRangeUpdate(ext_value);
+      }
+      else
+      {
+        HandleUpdate(ext_value);
+      }
+      if (m_latency && ext_value.connected)
+      {
+        m_latency->RecordUpdate(ext_value.timestamp, receipt_time, epics_helper::LatencyClock());
+      }
+      return;
+    };
+  m_connection = std::make_shared<epics_helper::ScheduledConnection>(priority);
+  if (m_mode == epics_helper::ClientMode::kMonitor)
+  {
+    m_monitored = std::make_shared<
+      epics_helper::MonitoredChannel<epics::ChannelAccessPV::ExtendedValue>>([this]() {
+        auto pv = m_pv.Get();
+        return pv != nullptr ? pv->GetExtendedValue() : epics::ChannelAccessPV::ExtendedValue{};
+      });
+    channel_access_helper::GetMonitorRegistry().Register(channel, channel_type, m_monitored);
+  }
+  m_pv.Create(
+    [channel, channel_type, callback]() {
+      return std::make_unique<epics::ChannelAccessPV>(channel, channel_type, callback);
+    },
+    true);
+  if (!lazy)
+  {
+    epics_helper::GetConnectionScheduler().Schedule(m_connection, [this]() { (void)m_pv.Get(); });
+  }
+  if (m_mode == epics_helper::ClientMode::kConnection)
+  {
+    Notify(sup::dto::AnyValue{false}, true);
+  }
+  return {};
+}
+
+void ChannelAccessClientVariable::TeardownImpl()
+{
+  if (m_monitored)
+  {
+    m_monitored->Close();
+  }
+  if (m_connection)
+  {
+    epics_helper::GetConnectionScheduler().Cancel(*m_connection);
+  }
+  m_pv.Reset();
+  m_connection.reset();
+  m_monitored.reset();
+  epics_helper::FlushTrace();
+  if (m_latency)
+  {
+    (void)epics_helper::AppendChannelLatency(*m_latency, m_latency_file);
+  }
+  m_latency.reset();
+  m_latency_file.clear();
+  m_payload_size = 0;
+  m_statistics.reset();
+  m_anytype = sup::dto::EmptyType;
+  m_monitor_mask = channel_access_helper::MONITOR_MASK_DEFAULT;
+  m_range = channel_access_helper::ElementRange{0, 0};
+  m_range_update = epics::ChannelAccessPV::ExtendedValue{};
+  m_last_update = epics::ChannelAccessPV::ExtendedValue{};
+  m_mode = epics_helper::ClientMode::kMonitor;
+}
+
+void ChannelAccessClientVariable::HandleUpdate(
+  const epics::ChannelAccessPV::ExtendedValue& ext_value)
+{
+  m_monitored->SetLastUpdate(ext_value.connected ? utils::GetNanosecsSinceEpoch() : 0);
+  m_statistics->SetConnected(ext_value.connected);
+  if (ext_value.connected)
+  {
+    m_connection->MarkConnected();
+    m_statistics->RecordUpdate(m_payload_size);
+  }
+  // The CA subscription itself uses the value and alarm mask of epics::ChannelAccessPV, so updates
+  // outside the selected event class are dropped here, before any conversion or notification.
+  if ((m_monitor_mask & channel_access_helper::MONITOR_MASK_DEFAULT) !=
+      channel_access_helper::MONITOR_MASK_DEFAULT)
+  {
+    bool matches =
+      channel_access_helper::UpdateMatchesMonitorMask(m_monitor_mask, m_last_update, ext_value);
+    // Only keep what the next comparison needs: the (scalar) value is only copied for DBE_VALUE,
+    // when it may have changed
+    m_last_update.connected = ext_value.connected;
+    m_last_update.status = ext_value.status;
+    m_last_update.severity = ext_value.severity;
+    if (!matches)
+    {
+      return;
+    }
+    if ((m_monitor_mask & channel_access_helper::MONITOR_MASK_VALUE) != 0)
+    {
+      m_last_update.value = ext_value.value;
+    }
+  }
+  sup::dto::AnyValue value;
+  {
+    epics_helper::TraceSpan conversion_span{"ChannelAccessClient.convert"};
+    value = channel_access_helper::ConvertToTypedAnyValue(ext_value, m_anytype);
+  }
+  if (ext_value.connected && sup::dto::IsEmptyValue(value))
+  {
+    m_statistics->RecordConversionFailure();
+  }
+  m_statistics->RecordNotify();
+  epics_helper::TraceSpan notify_span{"ChannelAccessClient.notify"};
+  Notify(value, ext_value.connected);
+}
+
+void ChannelAccessClientVariable::HandleRangeUpdate(
+  const epics::ChannelAccessPV::ExtendedValue& ext_value)
+{
+  // The range is extracted once per update, into the same value that get requests read
+  {
+    std::lock_guard<std::mutex> lk{m_range_mtx};
+    m_range_update.connected = ext_value.connected;
+    m_range_update.timestamp = ext_value.timestamp;
+    m_range_update.status = ext_value.status;
+    m_range_update.severity = ext_value.severity;
+    if (!sup::dto::IsArrayValue(m_range_update.value))
+    {
+      // First update or previous update without value
+      m_range_update.value = sup::dto::AnyValue{channel_access_helper::ChannelType(m_anytype)};
+    }
+    if (!channel_access_helper::CopyElementRange(m_range_update.value, ext_value.value, m_range))
+    {
+      // Disconnected or malformed update: pass it on without value
+      m_range_update.value = sup::dto::AnyValue{};
+    }
+  }
+  // Only this callback modifies the range update, so reading it does not require the lock
+  HandleUpdate(m_range_update);
+}
+
+void ChannelAccessClientVariable::HandleConnectionUpdate(bool connected)
+{
+  // Values are ignored: only changes of the connection state are notified
+  if (connected == m_last_update.connected)
+  {
+    return;
+  }
+  m_last_update.connected = connected;
+  m_statistics->SetConnected(connected);
+  if (connected)
+  {
+    m_connection->MarkConnected();
+  }
+  m_statistics->RecordNotify();
+  Notify(sup::dto::AnyValue{connected}, true);
+}
+
+sup::dto::AnyType ChannelAccessClientVariable::SetupChannelType(const Workspace& ws)
+{
+  if (!HasAttribute(TYPE_ATTRIBUTE_NAME))
+  {
+    std::string error_message = VariableSetupExceptionProlog(*this) +
+      "missing attribute [" + TYPE_ATTRIBUTE_NAME + "]";
+    throw VariableSetupException(error_message);
+  }
   sup::dto::JSONAnyTypeParser parser;
   auto type_attr_val = GetAttributeString(TYPE_ATTRIBUTE_NAME);
   const auto& registry = ws.GetTypeRegistry();
@@ -114,21 +417,49 @@ SetupTeardownActions ChannelAccessClientVariable::SetupImpl(const Workspace& ws)
       "parsed channel type [" + type_attr_val + "] is not supported";
     throw VariableSetupException(error_message);
   }
-  auto callback =
-    [this](const epics::ChannelAccessPV::ExtendedValue& ext_value) {
-      auto value = channel_access_helper::ConvertToTypedAnyValue(ext_value, m_anytype);
-      Notify(value, ext_value.connected);
-      return;
-    };
-  m_pv = std::make_unique<epics::ChannelAccessPV>(GetAttributeString(CHANNEL_ATTRIBUTE_NAME),
-                                        channel_type, callback);
-  return {};
+  m_range = channel_access_helper::ElementRange{0, 0};
+  if (HasAttribute(channel_access_helper::OFFSET_ATTRIBUTE_NAME) ||
+      HasAttribute(channel_access_helper::COUNT_ATTRIBUTE_NAME))
+  {
+    if (HasAttribute(channel_access_helper::OFFSET_ATTRIBUTE_NAME))
+    {
+      m_range.offset =
+        GetAttributeValue<sup::dto::uint64>(channel_access_helper::OFFSET_ATTRIBUTE_NAME);
+    }
+    if (HasAttribute(channel_access_helper::COUNT_ATTRIBUTE_NAME))
+    {
+      m_range.count =
+        GetAttributeValue<sup::dto::uint64>(channel_access_helper::COUNT_ATTRIBUTE_NAME);
+      if (m_range.count == 0)
+      {
+        std::string error_message = VariableSetupExceptionProlog(*this) +
+          "attribute [" + channel_access_helper::COUNT_ATTRIBUTE_NAME + "] cannot be zero";
+        throw VariableSetupException(error_message);
+      }
+    }
+    channel_type = channel_access_helper::RangedChannelType(channel_type, m_range);
+    if (sup::dto::IsEmptyType(channel_type))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "element range requires an array type with [" +
+        channel_access_helper::COUNT_ATTRIBUTE_NAME + "] elements, but type is [" +
+        type_attr_val + "]";
+      throw VariableSetupException(error_message);
+    }
+  }
+  return channel_type;
 }
 
-void ChannelAccessClientVariable::TeardownImpl()
+epics::ChannelAccessPV::ExtendedValue ChannelAccessClientVariable::GetChannelValue(
+  const epics::ChannelAccessPV& pv) const
 {
-  m_pv = nullptr;
-  m_anytype = sup::dto::EmptyType;
+  if (m_range.count == 0)
+  {
+    return pv.GetExtendedValue();
+  }
+  // The monitor callback already extracted the range
+  std::lock_guard<std::mutex> lk{m_range_mtx};
+  return m_range_update;
 }
 
 } // namespace oac_tree
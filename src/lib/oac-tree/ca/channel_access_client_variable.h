@@ -23,16 +23,23 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_CHANNEL_ACCESS_CLIENT_VARIABLE_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_CHANNEL_ACCESS_CLIENT_VARIABLE_H_
 
+#include "channel_access_helper.h"
+
+#include <oac-tree/common/connection_scheduler.h>
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/latency_histogram.h>
+#include <oac-tree/common/lazy_channel.h>
+#include <oac-tree/common/variable_statistics.h>
+
 #include <sup/oac-tree/variable.h>
 
+#include <sup/epics/channel_access_pv.h>
+
 #include <memory>
+#include <mutex>
 
 namespace sup
 {
-namespace epics
-{
-class ChannelAccessPV;
-}  // namespace epics
 
 namespace oac_tree
 {
@@ -46,6 +53,31 @@ namespace oac_tree
  * IOC records such as mbbi/mbbo can be accessed as integer or string.
  * The implementation provides as well a way to change the CA client thread period from
  * default using an optional 'period' attribute with ns resolution.
+ * The optional 'monitorMask' attribute ("DBE_VALUE" or "DBE_ALARM") drops received updates that
+ * do not change the value or the alarm status respectively, before conversion and notification.
+ * The subscription itself is not changed, so it does not reduce network traffic. Connection state
+ * changes are always propagated. As "DBE_VALUE" compares each update with a copy of the previous
+ * value, it is only accepted for scalar channels.
+ * For array channels, the optional unsigned 'offset' and 'count' attributes restrict the request
+ * to the first 'offset' + 'count' elements and expose only the last 'count' of them. The declared
+ * array type then needs to contain exactly 'count' elements, which is also the default count.
+ * Each update of the range is copied once, by the monitor callback, into a value that is allocated
+ * on the first update and that get requests read from.
+ * Runtime statistics of the variable are available through epics_helper::GetVariableStatistics.
+ * The optional 'latencyFile' attribute enables latency histograms of the updates (see
+ * epics_helper::ChannelLatency), which are appended to the given file on teardown.
+ * With the optional attribute connect="lazy", the channel is only created on the first access to
+ * the variable (get, set or availability check) instead of during setup. That access waits at most
+ * epics_helper::FIRST_ACCESS_TIMEOUT_SEC for the channel to connect.
+ * Otherwise, the channel is created through the plugin's connection scheduler (see
+ * epics_helper::ConnectionScheduler), where the optional 'connectPriority' attribute (default 0)
+ * orders the variables that wait for their turn.
+ * With mode="connection", the 'type' attribute is not needed: the variable only exposes the
+ * connection state of the channel as a boolean value, which is notified when it changes. The
+ * channel is then requested with a single byte payload and the variable cannot be set.
+ * In the default mode, the monitor of the variable is published in the plugin's monitor registry
+ * (see channel_access_helper::GetMonitorRegistry), where ChannelAccessRead instructions with a
+ * 'maxAge' attribute find it.
  *
  * @code
      <Workspace>
@@ -94,8 +126,26 @@ private:
   bool IsAvailableImpl() const override;
   SetupTeardownActions SetupImpl(const Workspace& ws) override;
   void TeardownImpl() override;
+  void HandleUpdate(const epics::ChannelAccessPV::ExtendedValue& ext_value);
+  void HandleRangeUpdate(const epics::ChannelAccessPV::ExtendedValue& ext_value);
+  void HandleConnectionUpdate(bool connected);
+  sup::dto::AnyType SetupChannelType(const Workspace& ws);
+  epics::ChannelAccessPV::ExtendedValue GetChannelValue(const epics::ChannelAccessPV& pv) const;
+  epics_helper::ClientMode m_mode;
   sup::dto::AnyType m_anytype;  // Order matters: this member has to be destroyed after the PV
-  std::unique_ptr<epics::ChannelAccessPV> m_pv;
+  sup::dto::uint32 m_monitor_mask;
+  channel_access_helper::ElementRange m_range;
+  mutable std::mutex m_range_mtx;
+  epics::ChannelAccessPV::ExtendedValue m_range_update;
+  epics::ChannelAccessPV::ExtendedValue m_last_update;
+  std::size_t m_payload_size;
+  std::shared_ptr<epics_helper::VariableStatistics> m_statistics;
+  std::string m_latency_file;
+  std::shared_ptr<epics_helper::ChannelLatency> m_latency;
+  std::shared_ptr<epics_helper::ScheduledConnection> m_connection;
+  std::shared_ptr<epics_helper::MonitoredChannel<epics::ChannelAccessPV::ExtendedValue>>
+    m_monitored;
+  mutable epics_helper::LazyChannel<epics::ChannelAccessPV> m_pv;
 };
 
 }  // namespace oac_tree
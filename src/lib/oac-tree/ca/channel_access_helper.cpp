@@ -22,12 +22,20 @@
 
 #include "channel_access_helper.h"
 
+#include <oac-tree/common/numeric_traits.h>
+
 #include <sup/dto/anyvalue_helper.h>
 
+#include <limits>
+#include <map>
+
 namespace
 {
 bool PopulateExtraFields(sup::dto::AnyValue& anyvalue,
                          const sup::epics::ChannelAccessPV::ExtendedValue& ext_value);
+bool HasType(const sup::dto::AnyValue& value, const sup::dto::AnyType& anytype);
+std::string TrimWhitespace(const std::string& str);
+std::size_t NumericElementSize(sup::dto::TypeCode type_code);
 }  // unnamed namespace
 
 namespace sup
@@ -50,6 +58,75 @@ sup::dto::AnyType ChannelType(const sup::dto::AnyType& anytype)
   return {};
 }
 
+sup::dto::AnyType RangedChannelType(const sup::dto::AnyType& channel_type, ElementRange& range)
+{
+  if (!sup::dto::IsArrayType(channel_type))
+  {
+    return {};
+  }
+  if (range.count == 0)
+  {
+    range.count = channel_type.NumberOfElements();
+  }
+  if (channel_type.NumberOfElements() != range.count || range.count == 0 ||
+      range.offset > std::numeric_limits<sup::dto::uint64>::max() - range.count)
+  {
+    return {};
+  }
+  return sup::dto::AnyType{range.offset + range.count, channel_type.ElementType(),
+                           channel_type.GetTypeName()};
+}
+
+sup::epics::ChannelAccessPV::ExtendedValue ExtractElementRange(
+  const sup::epics::ChannelAccessPV::ExtendedValue& ext_value, const ElementRange& range)
+{
+  // Only copy the metadata: the full value may be large
+  sup::epics::ChannelAccessPV::ExtendedValue result;
+  result.connected = ext_value.connected;
+  result.timestamp = ext_value.timestamp;
+  result.status = ext_value.status;
+  result.severity = ext_value.severity;
+  const auto& full_value = ext_value.value;
+  if (!sup::dto::IsArrayValue(full_value))
+  {
+    return result;
+  }
+  sup::dto::AnyType range_type{range.count, full_value.GetType().ElementType(),
+                               full_value.GetType().GetTypeName()};
+  sup::dto::AnyValue range_value{range_type};
+  if (CopyElementRange(range_value, full_value, range))
+  {
+    result.value = std::move(range_value);
+  }
+  return result;
+}
+
+bool CopyElementRange(sup::dto::AnyValue& range_value, const sup::dto::AnyValue& full_value,
+                      const ElementRange& range)
+{
+  if (!sup::dto::IsArrayValue(full_value) || !sup::dto::IsArrayValue(range_value) ||
+      range_value.NumberOfElements() != range.count ||
+      full_value.NumberOfElements() < range.offset + range.count ||
+      full_value.GetType().ElementType() != range_value.GetType().ElementType())
+  {
+    return false;
+  }
+  const auto element_size = NumericElementSize(range_value.GetType().ElementType().GetTypeCode());
+  if (element_size == 0)
+  {
+    for (sup::dto::uint64 idx = 0; idx < range.count; ++idx)
+    {
+      range_value[idx] = full_value[range.offset + idx];
+    }
+    return true;
+  }
+  // Numeric elements are packed: copy the range at once instead of assigning element by element
+  auto full_bytes = sup::dto::ToBytes(full_value);
+  sup::dto::FromBytes(range_value, full_bytes.data() + range.offset * element_size,
+                      range.count * element_size);
+  return true;
+}
+
 sup::dto::AnyValue ExtractChannelValue(const sup::dto::AnyValue& value)
 {
   if (!sup::dto::IsStructValue(value))
@@ -63,6 +140,53 @@ sup::dto::AnyValue ExtractChannelValue(const sup::dto::AnyValue& value)
   return {};
 }
 
+bool ParseMonitorMask(const std::string& mask_str, sup::dto::uint32& mask)
+{
+  static const std::map<std::string, sup::dto::uint32> event_classes = {
+    { "DBE_VALUE", MONITOR_MASK_VALUE },
+    { "DBE_ALARM", MONITOR_MASK_ALARM }
+  };
+  sup::dto::uint32 result = 0;
+  std::size_t start = 0;
+  while (start <= mask_str.size())
+  {
+    auto end = mask_str.find('|', start);
+    if (end == std::string::npos)
+    {
+      end = mask_str.size();
+    }
+    auto iter = event_classes.find(TrimWhitespace(mask_str.substr(start, end - start)));
+    if (iter == event_classes.end())
+    {
+      return false;
+    }
+    result |= iter->second;
+    start = end + 1;
+  }
+  mask = result;
+  return true;
+}
+
+bool UpdateMatchesMonitorMask(sup::dto::uint32 mask,
+                              const sup::epics::ChannelAccessPV::ExtendedValue& previous,
+                              const sup::epics::ChannelAccessPV::ExtendedValue& current)
+{
+  if (previous.connected != current.connected)
+  {
+    return true;
+  }
+  if ((mask & MONITOR_MASK_VALUE) != 0 && previous.value != current.value)
+  {
+    return true;
+  }
+  if ((mask & MONITOR_MASK_ALARM) != 0 &&
+      (previous.status != current.status || previous.severity != current.severity))
+  {
+    return true;
+  }
+  return false;
+}
+
 sup::dto::AnyValue ConvertToTypedAnyValue(
   const sup::epics::ChannelAccessPV::ExtendedValue& ext_value, const sup::dto::AnyType& anytype)
 {
@@ -70,7 +194,7 @@ sup::dto::AnyValue ConvertToTypedAnyValue(
   {
     return {};
   }
-  if (ext_value.value.GetType() == anytype)
+  if (HasType(ext_value.value, anytype))
   {
     return ext_value.value;
   }
@@ -87,6 +211,27 @@ sup::dto::AnyValue ConvertToTypedAnyValue(
   return result;
 }
 
+sup::dto::AnyValue ConvertToTypedAnyValue(
+  sup::epics::ChannelAccessPV::ExtendedValue&& ext_value, const sup::dto::AnyType& anytype)
+{
+  if (!anytype.HasField(CONNECTED_FIELD_NAME) && !ext_value.connected)
+  {
+    return {};
+  }
+  if (HasType(ext_value.value, anytype))
+  {
+    return std::move(ext_value.value);
+  }
+  const auto& const_ext_value = ext_value;
+  return ConvertToTypedAnyValue(const_ext_value, anytype);
+}
+
+epics_helper::MonitorRegistry<sup::epics::ChannelAccessPV::ExtendedValue>& GetMonitorRegistry()
+{
+  static epics_helper::MonitorRegistry<sup::epics::ChannelAccessPV::ExtendedValue> registry{};
+  return registry;
+}
+
 } // namespace channel_access_helper
 
 } // namespace oac_tree
@@ -123,4 +268,36 @@ bool PopulateExtraFields(sup::dto::AnyValue& anyvalue,
   }
   return true;
 }
+
+// Scalar types are fully determined by their type code, which avoids copying and comparing the
+// complete types for every update of a scalar channel.
+bool HasType(const sup::dto::AnyValue& value, const sup::dto::AnyType& anytype)
+{
+  if (sup::dto::IsScalarType(anytype))
+  {
+    return value.GetTypeCode() == anytype.GetTypeCode();
+  }
+  return value.GetType() == anytype;
+}
+
+std::string TrimWhitespace(const std::string& str)
+{
+  const std::string whitespace = " \t";
+  auto first = str.find_first_not_of(whitespace);
+  if (first == std::string::npos)
+  {
+    return {};
+  }
+  auto last = str.find_last_not_of(whitespace);
+  return str.substr(first, last - first + 1);
+}
+
+// Size of a numeric element in its packed representation or zero for other element types.
+std::size_t NumericElementSize(sup::dto::TypeCode type_code)
+{
+  auto element_size = [](auto tag) {
+    return sizeof(typename decltype(tag)::type);
+  };
+  return sup::oac_tree::epics_helper::DispatchNumericType(type_code, element_size, std::size_t{0});
+}
 }  // unnamed namespace
@@ -23,10 +23,13 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_CHANNEL_ACCESS_HELPER_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_CHANNEL_ACCESS_HELPER_H_
 
+#include <oac-tree/common/monitor_registry.h>
+
 #include <sup/dto/anyvalue.h>
 #include <sup/epics/channel_access_pv.h>
 
 #include <memory>
+#include <string>
 
 namespace sup
 {
@@ -37,6 +40,9 @@ namespace channel_access_helper
 const sup::dto::int64 DEFAULT_TIMEOUT_NS = 2000000000;  // 2 seconds
 
 const std::string CHANNEL_ATTRIBUTE_NAME = "channel";
+const std::string MONITOR_MASK_ATTRIBUTE_NAME = "monitorMask";
+const std::string OFFSET_ATTRIBUTE_NAME = "offset";
+const std::string COUNT_ATTRIBUTE_NAME = "count";
 
 const std::string VALUE_FIELD_NAME = "value";
 const std::string CONNECTED_FIELD_NAME = "connected";
@@ -44,13 +50,98 @@ const std::string TIMESTAMP_FIELD_NAME = "timestamp";
 const std::string STATUS_FIELD_NAME = "status";
 const std::string SEVERITY_FIELD_NAME = "severity";
 
+// Monitor event classes, using the same bit values as the DBE_* constants of EPICS base. Only the
+// classes of the subscription of epics::ChannelAccessPV (value and alarm) can be selected.
+const sup::dto::uint32 MONITOR_MASK_VALUE = 0x1;
+const sup::dto::uint32 MONITOR_MASK_ALARM = 0x4;
+const sup::dto::uint32 MONITOR_MASK_DEFAULT = MONITOR_MASK_VALUE | MONITOR_MASK_ALARM;
+
+/**
+ * @brief Slice of an array channel, starting at element 'offset' and containing 'count' elements.
+ */
+struct ElementRange
+{
+  sup::dto::uint64 offset;
+  sup::dto::uint64 count;
+};
+
 sup::dto::AnyType ChannelType(const sup::dto::AnyType& anytype);
 
+/**
+ * @brief Compute the channel type to request for reading the given range of an array channel.
+ *
+ * @details Only 'offset' + 'count' elements are requested from the server. A zero 'count' in
+ * 'range' is replaced by the number of elements of 'channel_type'.
+ *
+ * @param channel_type Array type of the requested range.
+ * @param range Element range.
+ * @return Array type to request or empty type when the range is not compatible with the type.
+ */
+sup::dto::AnyType RangedChannelType(const sup::dto::AnyType& channel_type, ElementRange& range);
+
+/**
+ * @brief Extract the given range from the value obtained with a type from RangedChannelType.
+ *
+ * @param ext_value Value received from the channel.
+ * @param range Element range.
+ * @return Extended value containing only the requested elements or an empty value field when the
+ * range could not be extracted.
+ */
+sup::epics::ChannelAccessPV::ExtendedValue ExtractElementRange(
+  const sup::epics::ChannelAccessPV::ExtendedValue& ext_value, const ElementRange& range);
+
+/**
+ * @brief Copy the given range from the value obtained with a type from RangedChannelType into an
+ * existing array with the type of the range, without allocating a new value.
+ *
+ * @details Numeric elements are copied at once through their packed representation, other
+ * elements one by one.
+ *
+ * @param range_value Destination array of 'range.count' elements.
+ * @param full_value Value received from the channel.
+ * @param range Element range.
+ * @return true on success. On failure, 'range_value' is left untouched.
+ */
+bool CopyElementRange(sup::dto::AnyValue& range_value, const sup::dto::AnyValue& full_value,
+                      const ElementRange& range);
+
 sup::dto::AnyValue ExtractChannelValue(const sup::dto::AnyValue& value);
 
+/**
+ * @brief Parse a monitor mask attribute, e.g. "DBE_VALUE" or "DBE_VALUE|DBE_ALARM".
+ *
+ * @param mask_str String representation of the mask: DBE_VALUE and/or DBE_ALARM separated by '|'.
+ * @param mask Output parameter for the parsed mask.
+ * @return true on successful parsing.
+ * @note DBE_LOG (DBE_ARCHIVE) and DBE_PROPERTY are rejected: they select events that the IOC
+ * generates from the subscription mask, which epics::ChannelAccessPV does not expose.
+ */
+bool ParseMonitorMask(const std::string& mask_str, sup::dto::uint32& mask);
+
+/**
+ * @brief Check if an update belongs to one of the event classes selected by the monitor mask.
+ *
+ * @details Connection state changes always pass. Value changes pass for DBE_VALUE, while
+ * status/severity changes pass for DBE_ALARM. This is a client-side filter of the updates that
+ * were already received.
+ */
+bool UpdateMatchesMonitorMask(sup::dto::uint32 mask,
+                              const sup::epics::ChannelAccessPV::ExtendedValue& previous,
+                              const sup::epics::ChannelAccessPV::ExtendedValue& current);
+
 sup::dto::AnyValue ConvertToTypedAnyValue(
   const sup::epics::ChannelAccessPV::ExtendedValue& ext_value, const sup::dto::AnyType& anytype);
 
+// Overload that moves the channel's value into the result when no conversion is required
+sup::dto::AnyValue ConvertToTypedAnyValue(
+  sup::epics::ChannelAccessPV::ExtendedValue&& ext_value, const sup::dto::AnyType& anytype);
+
+/**
+ * @brief Registry of the live monitors of ChannelAccessClient variables, by channel name and
+ * channel type (including the requested number of elements).
+ */
+epics_helper::MonitorRegistry<sup::epics::ChannelAccessPV::ExtendedValue>& GetMonitorRegistry();
+
 }  // namespace channel_access_helper
 
 }  // namespace oac_tree
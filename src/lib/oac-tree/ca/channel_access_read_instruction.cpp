@@ -23,11 +23,15 @@
 #include "channel_access_read_instruction.h"
 #include "channel_access_helper.h"
 
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/trace.h>
+
 #include <sup/oac-tree/constants.h>
 #include <sup/oac-tree/exceptions.h>
 #include <sup/oac-tree/generic_utils.h>
 #include <sup/oac-tree/instruction_registry.h>
 #include <sup/oac-tree/instruction_utils.h>
+#include <sup/oac-tree/procedure.h>
 #include <sup/oac-tree/user_interface.h>
 #include <sup/oac-tree/workspace.h>
 
@@ -51,8 +55,13 @@ ChannelAccessReadInstruction::ChannelAccessReadInstruction()
   , m_channel_name{}
   , m_var_field_name{}
   , m_var_type{}
+  , m_range{0, 0}
+  , m_channel_type{}
   , m_finish{}
+  , m_monitored_value{}
   , m_pv{}
+  , m_wakeup{std::make_shared<epics_helper::WakeupSignal>()}
+  , m_prefetched{}
 {
   (void)AddAttributeDefinition(channel_access_helper::CHANNEL_ATTRIBUTE_NAME)
     .SetCategory(AttributeCategory::kBoth).SetMandatory();
@@ -60,12 +69,52 @@ ChannelAccessReadInstruction::ChannelAccessReadInstruction()
     .SetCategory(AttributeCategory::kVariableName).SetMandatory();
   (void)AddAttributeDefinition(Constants::TIMEOUT_SEC_ATTRIBUTE_NAME, sup::dto::Float64Type)
     .SetCategory(AttributeCategory::kBoth);
+  (void)AddAttributeDefinition(channel_access_helper::OFFSET_ATTRIBUTE_NAME,
+                               sup::dto::UnsignedInteger64Type)
+    .SetCategory(AttributeCategory::kBoth);
+  (void)AddAttributeDefinition(channel_access_helper::COUNT_ATTRIBUTE_NAME,
+                               sup::dto::UnsignedInteger64Type)
+    .SetCategory(AttributeCategory::kBoth);
+  (void)AddAttributeDefinition(epics_helper::MAX_AGE_ATTRIBUTE_NAME, sup::dto::Float64Type)
+    .SetCategory(AttributeCategory::kBoth);
 }
 
 ChannelAccessReadInstruction::~ChannelAccessReadInstruction() = default;
 
+void ChannelAccessReadInstruction::SetupImpl(const Procedure& proc)
+{
+  // Start connecting to literal channels already, so the first execution finds them connected
+  auto channel = GetAttributeString(channel_access_helper::CHANNEL_ATTRIBUTE_NAME);
+  m_prefetched.SetEnabled(!epics_helper::IsVariableReference(channel));
+  if (!m_prefetched.IsEnabled())
+  {
+    return;
+  }
+  // The channel type follows from the output variable: skip prefetching when it is not known yet
+  sup::dto::AnyValue value;
+  auto var_field_name = GetAttributeString(Constants::OUTPUT_VARIABLE_NAME_ATTRIBUTE_NAME);
+  if (!proc.GetWorkspace().GetValue(var_field_name, value))
+  {
+    return;
+  }
+  // The range attributes may refer to workspace variables: the channel type of a range is only
+  // known at execution
+  if (HasAttribute(channel_access_helper::OFFSET_ATTRIBUTE_NAME) ||
+      HasAttribute(channel_access_helper::COUNT_ATTRIBUTE_NAME))
+  {
+    return;
+  }
+  auto channel_type = channel_access_helper::ChannelType(value.GetType());
+  if (sup::dto::IsEmptyType(channel_type))
+  {
+    return;
+  }
+  m_prefetched.Store(channel, channel_type, CreatePV(channel, channel_type));
+}
+
 bool ChannelAccessReadInstruction::InitHook(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan init_span{"ChannelAccessRead.init"};
   if (!GetAttributeValueAs(channel_access_helper::CHANNEL_ATTRIBUTE_NAME, ws, ui, m_channel_name))
   {
     return false;
@@ -85,25 +134,97 @@ bool ChannelAccessReadInstruction::InitHook(UserInterface& ui, Workspace& ws)
     LogWarning(ui, warning_message);
     return false;
   }
+  if (HasAttribute(channel_access_helper::OFFSET_ATTRIBUTE_NAME) ||
+      HasAttribute(channel_access_helper::COUNT_ATTRIBUTE_NAME))
+  {
+    m_range = channel_access_helper::ElementRange{0, 0};
+    if (!GetAttributeValueAs(channel_access_helper::OFFSET_ATTRIBUTE_NAME, ws, ui,
+                             m_range.offset) ||
+        !GetAttributeValueAs(channel_access_helper::COUNT_ATTRIBUTE_NAME, ws, ui, m_range.count))
+    {
+      return false;
+    }
+    if (HasAttribute(channel_access_helper::COUNT_ATTRIBUTE_NAME) && m_range.count == 0)
+    {
+      const std::string warning_message = InstructionWarningProlog(*this) +
+        "attribute [" + channel_access_helper::COUNT_ATTRIBUTE_NAME + "] cannot be zero";
+      LogWarning(ui, warning_message);
+      return false;
+    }
+    channel_type = channel_access_helper::RangedChannelType(channel_type, m_range);
+    if (sup::dto::IsEmptyType(channel_type))
+    {
+      const std::string warning_message = InstructionWarningProlog(*this) +
+        "element range requires variable field with name [" + m_var_field_name +
+        "] to be an array with [" + channel_access_helper::COUNT_ATTRIBUTE_NAME + "] elements";
+      LogWarning(ui, warning_message);
+      return false;
+    }
+  }
   sup::dto::uint64 timeout_ns = channel_access_helper::DEFAULT_TIMEOUT_NS;
   if (!instruction_utils::GetVariableTimeoutAttribute(
             *this, ui, ws, Constants::TIMEOUT_SEC_ATTRIBUTE_NAME, timeout_ns))
   {
     return false;
   }
-  m_finish = utils::GetNanosecsSinceEpoch() + timeout_ns;
-  m_pv = std::make_unique<sup::epics::ChannelAccessPV>(m_channel_name, channel_type);
+  sup::dto::float64 max_age_sec = 0.0;
+  sup::dto::uint64 max_age_ns = 0;
+  if (!GetAttributeValueAs(epics_helper::MAX_AGE_ATTRIBUTE_NAME, ws, ui, max_age_sec))
+  {
+    return false;
+  }
+  if (!epics_helper::SecondsToNanoseconds(max_age_sec, max_age_ns))
+  {
+    const std::string warning_message = InstructionWarningProlog(*this) +
+      "attribute [" + epics_helper::MAX_AGE_ATTRIBUTE_NAME + "] with value [" +
+      std::to_string(max_age_sec) + "] is not a valid age in seconds";
+    LogWarning(ui, warning_message);
+    return false;
+  }
+  auto now = utils::GetNanosecsSinceEpoch();
+  m_finish = now + timeout_ns;
+  m_channel_type = channel_type;
+  // Use the value of a client variable that monitors the channel if its last update is recent
+  if (max_age_ns > 0 &&
+      channel_access_helper::GetMonitorRegistry().GetValue(m_channel_name, m_channel_type,
+                                                           max_age_ns, now, m_monitored_value) &&
+      m_monitored_value.connected && !sup::dto::IsEmptyValue(m_monitored_value.value))
+  {
+    return true;
+  }
+  m_pv = m_prefetched.Take(m_channel_name, m_channel_type);
+  if (!m_pv)
+  {
+    m_pv = CreatePV(m_channel_name, m_channel_type);
+  }
   return true;
 }
 
 ExecutionStatus ChannelAccessReadInstruction::ExecuteSingleImpl(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan poll_span{"ChannelAccessRead.poll"};
   if (IsHaltRequested())
   {
     return ExecutionStatus::FAILURE;
   }
+  auto wakeup_count = m_wakeup->GetCount();
+  // Without channel, InitHook took a valid value from a live monitor of the channel
+  auto ext_val = m_pv ? m_pv->GetExtendedValue() : m_monitored_value;
+  if (!ext_val.connected || sup::dto::IsEmptyValue(ext_val.value))
+  {
+    // Wait (bounded) for the channel to connect instead of returning to be polled again
+    (void)m_wakeup->WaitForSignal(wakeup_count, m_finish);
+    if (IsHaltRequested())
+    {
+      return ExecutionStatus::FAILURE;
+    }
+    ext_val = m_pv->GetExtendedValue();
+  }
   auto now = utils::GetNanosecsSinceEpoch();
-  auto ext_val = m_pv->GetExtendedValue();
+  if (m_range.count != 0)
+  {
+    ext_val = channel_access_helper::ExtractElementRange(ext_val, m_range);
+  }
   if (!ext_val.connected || sup::dto::IsEmptyValue(ext_val.value))
   {
     if (m_finish > now)
@@ -115,6 +236,7 @@ ExecutionStatus ChannelAccessReadInstruction::ExecuteSingleImpl(UserInterface& u
     LogWarning(ui, warning_message);
     return ExecutionStatus::FAILURE;
   }
+  epics_helper::TraceInstant("ChannelAccessRead.connected");
   auto var_val = channel_access_helper::ConvertToTypedAnyValue(ext_val, m_var_type);
   if (sup::dto::IsEmptyValue(var_val))
   {
@@ -134,16 +256,33 @@ ExecutionStatus ChannelAccessReadInstruction::ExecuteSingleImpl(UserInterface& u
 void ChannelAccessReadInstruction::ResetHook(UserInterface& ui)
 {
   Halt(ui);
+  m_var_field_name = "";
+  m_var_type = sup::dto::EmptyType;
+  m_range = channel_access_helper::ElementRange{0, 0};
+  m_finish = 0;
+  m_channel_name = "";
+  m_channel_type = sup::dto::EmptyType;
+  m_monitored_value = sup::epics::ChannelAccessPV::ExtendedValue{};
+  // Do not keep the channel and its monitor of an instruction that may not run again
+  m_pv.reset();
+  m_prefetched.Clear();
 }
 
 void ChannelAccessReadInstruction::HaltImpl(UserInterface& ui)
 {
   (void)ui;
-  m_channel_name = "";
-  m_var_field_name = "";
-  m_var_type = sup::dto::EmptyType;
-  m_finish = 0;
-  m_pv.reset();
+  // Only wake up a waiting execution: it may still use the channel until it sees the halt request,
+  // so the channel is released on reset
+  m_wakeup->Signal();
+}
+
+std::unique_ptr<sup::epics::ChannelAccessPV> ChannelAccessReadInstruction::CreatePV(
+  const std::string& channel, const sup::dto::AnyType& channel_type) const
+{
+  auto callback = [wakeup = m_wakeup](const sup::epics::ChannelAccessPV::ExtendedValue&) {
+    wakeup->Signal();
+  };
+  return std::make_unique<sup::epics::ChannelAccessPV>(channel, channel_type, callback);
 }
 
 } // namespace oac_tree
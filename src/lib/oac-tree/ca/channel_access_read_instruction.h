@@ -23,6 +23,11 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_CHANNEL_ACCESS_READ_INSTRUCTION_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_CHANNEL_ACCESS_READ_INSTRUCTION_H_
 
+#include "channel_access_helper.h"
+
+#include <oac-tree/common/prefetched_channel.h>
+#include <oac-tree/common/wakeup_signal.h>
+
 #include <sup/oac-tree/instruction.h>
 
 #include <memory>
@@ -46,6 +51,9 @@ namespace oac_tree
  * in case the configured 'channel' can not be accessed within a timeout, which has a default
  * value of 2 seconds. Upon successful read, the specified workspace variable is updated.
  * The type of the workspace variable defines how the client-side tries and read the remote channel.
+ * For array channels, the optional unsigned 'offset' and 'count' attributes only request the first
+ * 'offset' + 'count' elements and write the last 'count' of them to the workspace. 'count' defaults
+ * to the number of elements of the output variable.
  *
  * @code
      <Sequence>
@@ -74,6 +82,14 @@ namespace oac_tree
    @endcode
  *
  * @note EPICS CA support is provided through this class and also as asynchronous variables.
+ * @note When the 'channel' attribute is a literal name and the type of the output variable is known
+ * at procedure setup, the channel is created during setup, so it is usually connected by the time
+ * the instruction first runs. When the output variable has no value at setup, this is skipped and
+ * the first execution creates the channel. The channel holds a monitor on the IOC until the
+ * instruction is reset.
+ * @note With the optional 'maxAge' attribute (seconds), the instruction takes the value from a
+ * ChannelAccessClient variable that monitors the same channel with the same channel type, if it
+ * received its last update at most 'maxAge' seconds ago. No channel is then accessed.
  */
 class ChannelAccessReadInstruction : public Instruction
 {
@@ -87,8 +103,15 @@ private:
   std::string m_channel_name;
   std::string m_var_field_name;
   sup::dto::AnyType m_var_type;
+  channel_access_helper::ElementRange m_range;
+  sup::dto::AnyType m_channel_type;
   sup::dto::uint64 m_finish;
+  sup::epics::ChannelAccessPV::ExtendedValue m_monitored_value;
   std::unique_ptr<sup::epics::ChannelAccessPV> m_pv;
+  std::shared_ptr<epics_helper::WakeupSignal> m_wakeup;
+  epics_helper::PrefetchedChannel<sup::epics::ChannelAccessPV> m_prefetched;
+
+  void SetupImpl(const Procedure& proc) override;
 
   bool InitHook(UserInterface& ui, Workspace& ws) override;
 
@@ -97,6 +120,9 @@ private:
   void ResetHook(UserInterface& ui) override;
 
   void HaltImpl(UserInterface& ui) override;
+
+  std::unique_ptr<sup::epics::ChannelAccessPV> CreatePV(
+    const std::string& channel, const sup::dto::AnyType& channel_type) const;
 };
 
 }  // namespace oac_tree
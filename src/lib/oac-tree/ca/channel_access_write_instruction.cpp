@@ -23,20 +23,27 @@
 #include "channel_access_write_instruction.h"
 #include "channel_access_helper.h"
 
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/plugin_diagnostics.h>
+#include <oac-tree/common/trace.h>
+
 #include <sup/oac-tree/constants.h>
 #include <sup/oac-tree/concrete_constraints.h>
 #include <sup/oac-tree/exceptions.h>
 #include <sup/oac-tree/generic_utils.h>
 #include <sup/oac-tree/instruction_registry.h>
 #include <sup/oac-tree/instruction_utils.h>
+#include <sup/oac-tree/procedure.h>
 #include <sup/oac-tree/user_interface.h>
 #include <sup/oac-tree/workspace.h>
 
 #include <sup/dto/anytype.h>
 #include <sup/dto/anyvalue.h>
 #include <sup/dto/anyvalue_helper.h>
+#include <sup/dto/json_type_parser.h>
 #include <sup/epics/channel_access_pv.h>
 
+
 namespace sup {
 
 namespace oac_tree {
@@ -51,7 +58,10 @@ ChannelAccessWriteInstruction::ChannelAccessWriteInstruction()
   , m_channel_name{}
   , m_value{}
   , m_finish{}
+  , m_only_if_changed{false}
   , m_pv{}
+  , m_wakeup{std::make_shared<epics_helper::WakeupSignal>()}
+  , m_prefetched{}
 {
   (void)AddAttributeDefinition(channel_access_helper::CHANNEL_ATTRIBUTE_NAME)
     .SetCategory(AttributeCategory::kBoth).SetMandatory();
@@ -61,6 +71,9 @@ ChannelAccessWriteInstruction::ChannelAccessWriteInstruction()
   (void)AddAttributeDefinition(Constants::VALUE_ATTRIBUTE_NAME);
   (void)AddAttributeDefinition(Constants::TIMEOUT_SEC_ATTRIBUTE_NAME, sup::dto::Float64Type)
     .SetCategory(AttributeCategory::kBoth);
+  (void)AddAttributeDefinition(epics_helper::ONLY_IF_CHANGED_ATTRIBUTE_NAME,
+                               sup::dto::BooleanType)
+    .SetCategory(AttributeCategory::kBoth);
   AddConstraint(MakeConstraint<Xor>(
     MakeConstraint<Exists>(Constants::GENERIC_VARIABLE_NAME_ATTRIBUTE_NAME),
     MakeConstraint<And>(MakeConstraint<Exists>(Constants::TYPE_ATTRIBUTE_NAME),
@@ -69,8 +82,49 @@ ChannelAccessWriteInstruction::ChannelAccessWriteInstruction()
 
 ChannelAccessWriteInstruction::~ChannelAccessWriteInstruction() = default;
 
+void ChannelAccessWriteInstruction::SetupImpl(const Procedure& proc)
+{
+  // Start connecting to literal channels already, so the first execution finds them connected
+  auto channel = GetAttributeString(channel_access_helper::CHANNEL_ATTRIBUTE_NAME);
+  m_prefetched.SetEnabled(!epics_helper::IsVariableReference(channel));
+  if (!m_prefetched.IsEnabled())
+  {
+    return;
+  }
+  // The channel type follows from the value: skip prefetching when it is not known yet
+  const auto& ws = proc.GetWorkspace();
+  sup::dto::AnyValue value;
+  if (HasAttribute(Constants::GENERIC_VARIABLE_NAME_ATTRIBUTE_NAME))
+  {
+    auto var_field_name = GetAttributeString(Constants::GENERIC_VARIABLE_NAME_ATTRIBUTE_NAME);
+    if (!ws.GetValue(var_field_name, value))
+    {
+      return;
+    }
+  }
+  else
+  {
+    auto type_str = GetAttributeString(Constants::TYPE_ATTRIBUTE_NAME);
+    sup::dto::JSONAnyTypeParser parser;
+    const auto& registry = ws.GetTypeRegistry();
+    if (epics_helper::IsVariableReference(type_str) ||
+        !parser.ParseString(type_str, std::addressof(registry)))
+    {
+      return;
+    }
+    value = sup::dto::AnyValue{parser.MoveAnyType()};
+  }
+  auto channel_type = channel_access_helper::ExtractChannelValue(value).GetType();
+  if (sup::dto::IsEmptyType(channel_type))
+  {
+    return;
+  }
+  m_prefetched.Store(channel, channel_type, CreatePV(channel, channel_type));
+}
+
 bool ChannelAccessWriteInstruction::InitHook(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan init_span{"ChannelAccessWrite.init"};
   if (!GetAttributeValueAs(channel_access_helper::CHANNEL_ATTRIBUTE_NAME, ws, ui, m_channel_name))
   {
     return false;
@@ -90,21 +144,43 @@ bool ChannelAccessWriteInstruction::InitHook(UserInterface& ui, Workspace& ws)
   {
     return false;
   }
+  m_only_if_changed = false;
+  if (!GetAttributeValueAs(epics_helper::ONLY_IF_CHANGED_ATTRIBUTE_NAME, ws, ui,
+                           m_only_if_changed))
+  {
+    return false;
+  }
   m_finish = utils::GetNanosecsSinceEpoch() + timeout_ns;
-  m_pv = std::make_unique<sup::epics::ChannelAccessPV>(m_channel_name, channel_type);
+  m_pv = m_prefetched.Take(m_channel_name, channel_type);
+  if (!m_pv)
+  {
+    m_pv = CreatePV(m_channel_name, channel_type);
+  }
   return true;
 }
 
 ExecutionStatus ChannelAccessWriteInstruction::ExecuteSingleImpl(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan poll_span{"ChannelAccessWrite.poll"};
   (void)ws;
   if (IsHaltRequested())
   {
     return ExecutionStatus::FAILURE;
   }
+  auto wakeup_count = m_wakeup->GetCount();
+  auto connected = m_pv->IsConnected();
+  if (!connected)
+  {
+    // Wait (bounded) for the channel to connect instead of returning to be polled again
+    (void)m_wakeup->WaitForSignal(wakeup_count, m_finish);
+    if (IsHaltRequested())
+    {
+      return ExecutionStatus::FAILURE;
+    }
+    connected = m_pv->IsConnected();
+  }
   auto now = utils::GetNanosecsSinceEpoch();
-  auto ext_val = m_pv->GetExtendedValue();
-  if (!ext_val.connected)
+  if (!connected)
   {
     if (m_finish > now)
     {
@@ -115,6 +191,13 @@ ExecutionStatus ChannelAccessWriteInstruction::ExecuteSingleImpl(UserInterface&
     LogWarning(ui, warning_message);
     return ExecutionStatus::FAILURE;
   }
+  epics_helper::TraceInstant("ChannelAccessWrite.connected");
+  if (m_only_if_changed && ChannelHoldsValue())
+  {
+    epics_helper::TraceInstant("ChannelAccessWrite.skipped");
+    epics_helper::RecordSkippedWrite();
+    return ExecutionStatus::SUCCESS;
+  }
   if (!m_pv->SetValue(m_value))
   {
     auto json_value = sup::dto::ValuesToJSONString(m_value).substr(0, 1024);
@@ -141,18 +224,51 @@ sup::dto::AnyValue ChannelAccessWriteInstruction::GetNewValue(UserInterface& ui,
   return ParseAnyValueAttributePair(*this, ws, ui, Constants::TYPE_ATTRIBUTE_NAME, Constants::VALUE_ATTRIBUTE_NAME);
 }
 
+bool ChannelAccessWriteInstruction::ChannelHoldsValue() const
+{
+  // The own channel monitors the value with the same type as the value to write
+  auto ext_val = m_pv->GetExtendedValue();
+  if (!ext_val.connected || sup::dto::IsEmptyValue(ext_val.value))
+  {
+    // Its first update did not arrive yet: use a recent update of a client variable monitor
+    auto now = utils::GetNanosecsSinceEpoch();
+    if (!channel_access_helper::GetMonitorRegistry().GetValue(
+            m_channel_name, m_value.GetType(), epics_helper::ONLY_IF_CHANGED_MAX_AGE_NS, now,
+            ext_val) || !ext_val.connected)
+    {
+      return false;
+    }
+  }
+  return ext_val.value == m_value;
+}
+
 void ChannelAccessWriteInstruction::ResetHook(UserInterface& ui)
 {
   Halt(ui);
+  m_finish = 0;
+  m_channel_name = "";
+  m_value = sup::dto::AnyValue{};
+  m_only_if_changed = false;
+  // Do not keep the channel and its monitor of an instruction that may not run again
+  m_pv.reset();
+  m_prefetched.Clear();
 }
 
 void ChannelAccessWriteInstruction::HaltImpl(UserInterface& ui)
 {
   (void)ui;
-  m_channel_name = "";
-  m_value = sup::dto::AnyValue{};
-  m_finish = 0;
-  m_pv.reset();
+  // Only wake up a waiting execution: it may still use the channel until it sees the halt request,
+  // so the channel is released on reset
+  m_wakeup->Signal();
+}
+
+std::unique_ptr<sup::epics::ChannelAccessPV> ChannelAccessWriteInstruction::CreatePV(
+  const std::string& channel, const sup::dto::AnyType& channel_type) const
+{
+  auto callback = [wakeup = m_wakeup](const sup::epics::ChannelAccessPV::ExtendedValue&) {
+    wakeup->Signal();
+  };
+  return std::make_unique<sup::epics::ChannelAccessPV>(channel, channel_type, callback);
 }
 
 } // namespace oac_tree
@@ -23,6 +23,9 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_CHANNEL_ACCESS_WRITE_INSTRUCTION_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_CHANNEL_ACCESS_WRITE_INSTRUCTION_H_
 
+#include <oac-tree/common/prefetched_channel.h>
+#include <oac-tree/common/wakeup_signal.h>
+
 #include <sup/oac-tree/instruction.h>
 
 #include <memory>
@@ -73,6 +76,18 @@ namespace oac_tree
    @endcode
  *
  * @note EPICS CA support is provided through this class and also as asynchronous variables.
+ * @note When the 'channel' attribute is a literal name and the type of the value is known at
+ * procedure setup, the channel is created during setup, so it is usually connected by the time the
+ * instruction first runs. When the variable to write has no value or the type is a reference at
+ * setup, this is skipped and the first execution creates the channel. The channel holds a monitor
+ * on the IOC until the instruction is reset.
+ * @note With onlyIfChanged="true", the instruction succeeds without writing when the channel
+ * already holds the value. The remote value is taken from the monitor of the instruction's own
+ * channel or else from a connected ChannelAccessClient variable with the same channel and type
+ * whose last update is at most 10 seconds old (see channel_access_helper::GetMonitorRegistry).
+ * Skipped writes are counted in the plugin diagnostics. The comparison is approximate: a monitor
+ * only receives value changes larger than the deadband (MDEL) of the record, so a put whose value
+ * differs from the monitored value by less than the deadband may be skipped.
  */
 class ChannelAccessWriteInstruction : public Instruction
 {
@@ -86,7 +101,12 @@ private:
   std::string m_channel_name;
   sup::dto::AnyValue m_value;
   sup::dto::uint64 m_finish;
+  bool m_only_if_changed;
   std::unique_ptr<sup::epics::ChannelAccessPV> m_pv;
+  std::shared_ptr<epics_helper::WakeupSignal> m_wakeup;
+  epics_helper::PrefetchedChannel<sup::epics::ChannelAccessPV> m_prefetched;
+
+  void SetupImpl(const Procedure& proc) override;
 
   bool InitHook(UserInterface& ui, Workspace& ws) override;
 
@@ -96,7 +116,12 @@ private:
 
   void HaltImpl(UserInterface& ui) override;
 
+  std::unique_ptr<sup::epics::ChannelAccessPV> CreatePV(
+    const std::string& channel, const sup::dto::AnyType& channel_type) const;
+
   sup::dto::AnyValue GetNewValue(UserInterface& ui, Workspace& ws) const;
+
+  bool ChannelHoldsValue() const;
 };
 
 }  // namespace oac_tree
@@ -0,0 +1,320 @@
+/******************************************************************************
+* $HeadURL: $
+* $Id: $
+*
+* Project       : CODAC Supervision and Automation (SUP) oac-tree component
+*
+* Description   : Rate-limited scheduling of channel connections
+*
+* Author        : Walter Van Herck (IO)
+*
+* Copyright (c) : 2010-2026 ITER Organization,
+*                 CS 90 046
+*                 13067 St. Paul-lez-Durance Cedex
+*                 France
+* SPDX-License-Identifier: MIT
+*
+* This file is part of ITER CODAC software.
+* For the terms and conditions of redistribution or use of this software
+* refer to the file LICENSE located in the top level directory
+* of the distribution package.
+******************************************************************************/
+
+#include "connection_scheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace
+{
+double SearchRateFromEnvironment();
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+const std::string SEARCH_RATE_ENVIRONMENT_VARIABLE = "OAC_TREE_EPICS_SEARCH_RATE";
+
+bool ParseConnectPriority(const std::string& priority_str, sup::dto::int32& priority)
+{
+  char* end = nullptr;
+  auto result = std::strtol(priority_str.c_str(), &end, 10);
+  if (end == priority_str.c_str() || *end != '\0' ||
+      result < std::numeric_limits<sup::dto::int32>::min() ||
+      result > std::numeric_limits<sup::dto::int32>::max())
+  {
+    return false;
+  }
+  priority = static_cast<sup::dto::int32>(result);
+  return true;
+}
+
+ScheduledConnection::ScheduledConnection(sup::dto::int32 priority)
+  : m_priority{priority}
+  , m_connected{false}
+  , m_scheduler{nullptr}
+  , m_state{State::kIdle}
+  , m_counted{false}
+  , m_connect{}
+{}
+
+ScheduledConnection::~ScheduledConnection()
+{
+  auto scheduler = m_scheduler.load();
+  if (scheduler != nullptr)
+  {
+    scheduler->Cancel(*this);
+  }
+}
+
+sup::dto::int32 ScheduledConnection::GetPriority() const
+{
+  return m_priority;
+}
+
+void ScheduledConnection::MarkConnected()
+{
+  if (m_connected.load(std::memory_order_relaxed) || m_connected.exchange(true))
+  {
+    return;
+  }
+  auto scheduler = m_scheduler.load();
+  if (scheduler != nullptr)
+  {
+    scheduler->ConnectionEstablished(*this);
+  }
+}
+
+bool ScheduledConnection::IsConnected() const
+{
+  return m_connected.load();
+}
+
+ConnectionScheduler::ConnectionScheduler(double search_rate)
+  : m_mtx{}
+  , m_cv{}
+  , m_search_rate{std::max(search_rate, 0.0)}
+  , m_queue{}
+  , m_next_slot{}
+  , m_sequence{0}
+  , m_scheduled{0}
+  , m_queued{0}
+  , m_pending{0}
+  , m_burst_start{}
+  , m_time_to_all_connected{-1.0}
+  , m_stop{false}
+  , m_worker{}
+{}
+
+ConnectionScheduler::~ConnectionScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  if (m_worker.joinable())
+  {
+    m_worker.join();
+  }
+}
+
+void ConnectionScheduler::SetSearchRate(double search_rate)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_search_rate = std::max(search_rate, 0.0);
+  }
+  m_cv.notify_all();
+}
+
+double ConnectionScheduler::GetSearchRate() const
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  return m_search_rate;
+}
+
+void ConnectionScheduler::Schedule(const std::shared_ptr<ScheduledConnection>& connection,
+                                   std::function<void()> connect)
+{
+  std::unique_lock<std::mutex> lk{m_mtx};
+  connection->m_scheduler.store(this);
+  ++m_scheduled;
+  if (!connection->IsConnected())
+  {
+    if (m_pending == 0)
+    {
+      m_burst_start = Clock::now();
+      m_time_to_all_connected = -1.0;
+    }
+    ++m_pending;
+    connection->m_counted = true;
+  }
+  if (m_search_rate <= 0.0 && m_queued == 0)
+  {
+    connection->m_state = ScheduledConnection::State::kRunning;
+    lk.unlock();
+    connect();
+    lk.lock();
+    connection->m_state = ScheduledConnection::State::kDone;
+    lk.unlock();
+    m_cv.notify_all();
+    return;
+  }
+  connection->m_state = ScheduledConnection::State::kQueued;
+  connection->m_connect = std::move(connect);
+  m_queue.push(QueueEntry{connection->GetPriority(), m_sequence++, connection});
+  ++m_queued;
+  if (!m_worker.joinable())
+  {
+    m_worker = std::thread(&ConnectionScheduler::Run, this);
+  }
+  lk.unlock();
+  m_cv.notify_all();
+}
+
+void ConnectionScheduler::Cancel(ScheduledConnection& connection)
+{
+  std::unique_lock<std::mutex> lk{m_mtx};
+  m_cv.wait(lk, [&connection]() {
+    return connection.m_state != ScheduledConnection::State::kRunning;
+  });
+  if (connection.m_state == ScheduledConnection::State::kQueued)
+  {
+    // The entry in the queue is skipped when it is popped
+    --m_queued;
+    connection.m_connect = nullptr;
+  }
+  connection.m_state = ScheduledConnection::State::kDone;
+  Uncount(connection);
+  connection.m_scheduler.store(nullptr);
+}
+
+ConnectionSchedulerSnapshot ConnectionScheduler::GetSnapshot() const
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  double pending_since = -1.0;
+  if (m_pending > 0)
+  {
+    std::chrono::duration<double> elapsed = Clock::now() - m_burst_start;
+    pending_since = elapsed.count();
+  }
+  return ConnectionSchedulerSnapshot{m_search_rate, m_scheduled, m_queued, m_pending,
+                                     m_time_to_all_connected, pending_since};
+}
+
+bool ConnectionScheduler::QueueOrder::operator()(const QueueEntry& left,
+                                                  const QueueEntry& right) const
+{
+  // std::priority_queue pops the largest element: highest priority, then lowest sequence
+  if (left.priority != right.priority)
+  {
+    return left.priority < right.priority;
+  }
+  return left.sequence > right.sequence;
+}
+
+void ConnectionScheduler::ConnectionEstablished(ScheduledConnection& connection)
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  Uncount(connection);
+}
+
+void ConnectionScheduler::Uncount(ScheduledConnection& connection)
+{
+  if (!connection.m_counted)
+  {
+    return;
+  }
+  connection.m_counted = false;
+  --m_pending;
+  if (m_pending == 0)
+  {
+    std::chrono::duration<double> elapsed = Clock::now() - m_burst_start;
+    m_time_to_all_connected = elapsed.count();
+  }
+}
+
+void ConnectionScheduler::Run()
+{
+  std::unique_lock<std::mutex> lk{m_mtx};
+  while (true)
+  {
+    m_cv.wait(lk, [this]() { return m_stop || !m_queue.empty(); });
+    if (m_stop)
+    {
+      return;
+    }
+    auto now = Clock::now();
+    if (m_search_rate > 0.0 && now < m_next_slot)
+    {
+      (void)m_cv.wait_until(lk, m_next_slot);
+      continue;
+    }
+    auto connection = m_queue.top().connection.lock();
+    m_queue.pop();
+    if (!connection || connection->m_state != ScheduledConnection::State::kQueued)
+    {
+      continue;
+    }
+    --m_queued;
+    connection->m_state = ScheduledConnection::State::kRunning;
+    auto connect = std::move(connection->m_connect);
+    connection->m_connect = nullptr;
+    lk.unlock();
+    try
+    {
+      connect();
+    }
+    catch (...)
+    {
+      // Creating the channel failed: the variable stays disconnected
+    }
+    lk.lock();
+    connection->m_state = ScheduledConnection::State::kDone;
+    if (m_search_rate > 0.0)
+    {
+      auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / m_search_rate));
+      m_next_slot = std::max(now, m_next_slot) + interval;
+    }
+    m_cv.notify_all();
+  }
+}
+
+ConnectionScheduler& GetConnectionScheduler()
+{
+  static ConnectionScheduler scheduler{SearchRateFromEnvironment()};
+  return scheduler;
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+namespace
+{
+double SearchRateFromEnvironment()
+{
+  const char* rate_str = std::getenv(
+    sup::oac_tree::epics_helper::SEARCH_RATE_ENVIRONMENT_VARIABLE.c_str());
+  if (rate_str == nullptr)
+  {
+    return 0.0;
+  }
+  char* end = nullptr;
+  auto rate = std::strtod(rate_str, &end);
+  if (end == rate_str || *end != '\0' || !(rate > 0.0))
+  {
+    return 0.0;
+  }
+  return rate;
+}
+}  // unnamed namespace
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Rate-limited scheduling of channel connections
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_CONNECTION_SCHEDULER_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_CONNECTION_SCHEDULER_H_
+
+#include <sup/dto/anyvalue.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Name of the environment variable that sets the initial connection budget of the plugins
+ * in channel searches per second. When it is not set (or zero), connections are not throttled.
+ */
+extern const std::string SEARCH_RATE_ENVIRONMENT_VARIABLE;
+
+const std::string CONNECT_PRIORITY_ATTRIBUTE_NAME = "connectPriority";
+
+/**
+ * @brief Parse the 'connectPriority' attribute of a client variable: a signed integer, where
+ * higher priorities connect first.
+ */
+bool ParseConnectPriority(const std::string& priority_str, sup::dto::int32& priority);
+
+/**
+ * @brief Copy of the state of the connection scheduler at a given time.
+ */
+struct ConnectionSchedulerSnapshot
+{
+  double search_rate;          // Searches per second, zero when not throttled
+  sup::dto::uint64 scheduled;  // Total number of scheduled connections
+  sup::dto::uint64 queued;     // Connections waiting for their turn
+  sup::dto::uint64 pending;    // Scheduled connections that are not connected yet
+  // Seconds from the first connection scheduled while none were pending until all of them were
+  // connected. Negative while connections are pending or when none were scheduled yet.
+  double time_to_all_connected;
+  // Seconds since that first connection was scheduled, while connections are pending, so channels
+  // that never connect remain visible. Negative when no connections are pending.
+  double pending_since;
+};
+
+class ConnectionScheduler;
+
+/**
+ * @brief Connection of a single client variable, as seen by the connection scheduler.
+ *
+ * @details The owner creates it before its channel, so the channel callback can report the
+ * first successful connection with MarkConnected(). Destroying it cancels the connection.
+ */
+class ScheduledConnection
+{
+public:
+  explicit ScheduledConnection(sup::dto::int32 priority);
+  ~ScheduledConnection();
+
+  ScheduledConnection(const ScheduledConnection&) = delete;
+  ScheduledConnection& operator=(const ScheduledConnection&) = delete;
+
+  sup::dto::int32 GetPriority() const;
+
+  /**
+   * @brief Report that the channel is connected. Only the first call has an effect, so this can
+   * be called for every update.
+   */
+  void MarkConnected();
+
+  bool IsConnected() const;
+
+private:
+  friend class ConnectionScheduler;
+  enum class State
+  {
+    kIdle,
+    kQueued,
+    kRunning,
+    kDone
+  };
+  const sup::dto::int32 m_priority;
+  std::atomic<bool> m_connected;
+  std::atomic<ConnectionScheduler*> m_scheduler;
+  // Guarded by the mutex of the scheduler
+  State m_state;
+  bool m_counted;
+  std::function<void()> m_connect;
+};
+
+/**
+ * @brief Spreads the creation of channels over time with a budget of searches per second.
+ *
+ * @details Without throttling, a procedure with thousands of client variables issues all channel
+ * searches at once during setup. The resulting burst of UDP traffic can overwhelm IOCs and
+ * gateways, causing searches to be retried much later. When a search rate is configured, the
+ * scheduler creates the channels from a worker thread at that rate, highest priority first and in
+ * the order of scheduling for equal priorities. Otherwise, channels are created immediately.
+ */
+class ConnectionScheduler
+{
+public:
+  explicit ConnectionScheduler(double search_rate = 0.0);
+  ~ConnectionScheduler();
+
+  ConnectionScheduler(const ConnectionScheduler&) = delete;
+  ConnectionScheduler& operator=(const ConnectionScheduler&) = delete;
+
+  /**
+   * @brief Set the budget in channel searches per second. Zero disables throttling.
+   */
+  void SetSearchRate(double search_rate);
+
+  double GetSearchRate() const;
+
+  /**
+   * @brief Schedule the creation of a channel. Without throttling, the function is called
+   * immediately from the calling thread.
+   *
+   * @param connection Connection that reports when the channel is connected.
+   * @param connect Function that creates the channel.
+   */
+  void Schedule(const std::shared_ptr<ScheduledConnection>& connection,
+                std::function<void()> connect);
+
+  /**
+   * @brief Cancel a scheduled connection. When its function is running, this waits until it
+   * returns, so the objects it refers to can be destroyed afterwards.
+   */
+  void Cancel(ScheduledConnection& connection);
+
+  ConnectionSchedulerSnapshot GetSnapshot() const;
+
+private:
+  friend class ScheduledConnection;
+  using Clock = std::chrono::steady_clock;
+  struct QueueEntry
+  {
+    sup::dto::int32 priority;
+    sup::dto::uint64 sequence;
+    std::weak_ptr<ScheduledConnection> connection;
+  };
+  struct QueueOrder
+  {
+    bool operator()(const QueueEntry& left, const QueueEntry& right) const;
+  };
+  void ConnectionEstablished(ScheduledConnection& connection);
+  void Uncount(ScheduledConnection& connection);
+  void Run();
+  mutable std::mutex m_mtx;
+  std::condition_variable m_cv;
+  double m_search_rate;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, QueueOrder> m_queue;
+  Clock::time_point m_next_slot;
+  sup::dto::uint64 m_sequence;
+  sup::dto::uint64 m_scheduled;
+  sup::dto::uint64 m_queued;
+  sup::dto::uint64 m_pending;
+  Clock::time_point m_burst_start;
+  double m_time_to_all_connected;
+  bool m_stop;
+  std::thread m_worker;
+};
+
+/**
+ * @brief Connection scheduler shared by all client variables of the plugins. Its initial search
+ * rate is read from SEARCH_RATE_ENVIRONMENT_VARIABLE.
+ */
+ConnectionScheduler& GetConnectionScheduler();
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_CONNECTION_SCHEDULER_H_
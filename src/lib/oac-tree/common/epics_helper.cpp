@@ -0,0 +1,98 @@
+/******************************************************************************
+* $HeadURL: $
+* $Id: $
+*
+* Project       : CODAC Supervision and Automation (SUP) oac-tree component
+*
+* Description   : Helper functions shared by the EPICS plugins
+*
+* Author        : Walter Van Herck (IO)
+*
+* Copyright (c) : 2010-2026 ITER Organization,
+*                 CS 90 046
+*                 13067 St. Paul-lez-Durance Cedex
+*                 France
+* SPDX-License-Identifier: MIT
+*
+* This file is part of ITER CODAC software.
+* For the terms and conditions of redistribution or use of this software
+* refer to the file LICENSE located in the top level directory
+* of the distribution package.
+******************************************************************************/
+
+#include "epics_helper.h"
+
+#include <sup/dto/anyvalue_helper.h>
+
+#include <cstdlib>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+const char VARIABLE_REFERENCE_PREFIX = '@';
+
+bool MoveOrAssign(sup::dto::AnyValue& dest, sup::dto::AnyValue&& src)
+{
+  if (sup::dto::IsEmptyValue(dest))
+  {
+    dest = std::move(src);
+    return true;
+  }
+  return sup::dto::TryAssign(dest, src);
+}
+
+bool IsVariableReference(const std::string& attr_str)
+{
+  return !attr_str.empty() && attr_str[0] == VARIABLE_REFERENCE_PREFIX;
+}
+
+bool ParseClientMode(const std::string& mode_str, ClientMode& mode)
+{
+  if (mode_str == MODE_MONITOR)
+  {
+    mode = ClientMode::kMonitor;
+    return true;
+  }
+  if (mode_str == MODE_CONNECTION)
+  {
+    mode = ClientMode::kConnection;
+    return true;
+  }
+  if (mode_str == MODE_GET)
+  {
+    mode = ClientMode::kGet;
+    return true;
+  }
+  return false;
+}
+
+bool ParseSeconds(const std::string& seconds_str, sup::dto::uint64& duration_ns)
+{
+  char* end = nullptr;
+  auto seconds = std::strtod(seconds_str.c_str(), &end);
+  if (end == seconds_str.c_str() || *end != '\0')
+  {
+    return false;
+  }
+  return SecondsToNanoseconds(seconds, duration_ns);
+}
+
+bool SecondsToNanoseconds(sup::dto::float64 seconds, sup::dto::uint64& duration_ns)
+{
+  if (!(seconds >= 0.0) || seconds > 1.8e10)
+  {
+    return false;
+  }
+  duration_ns = static_cast<sup::dto::uint64>(seconds * 1e9);
+  return true;
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Helper functions shared by the EPICS plugins
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_EPICS_HELPER_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_EPICS_HELPER_H_
+
+#include <sup/dto/anyvalue.h>
+
+#include <string>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+const std::string MODE_ATTRIBUTE_NAME = "mode";
+const std::string MODE_MONITOR = "monitor";
+const std::string MODE_CONNECTION = "connection";
+const std::string MODE_GET = "get";
+
+const std::string MAX_AGE_ATTRIBUTE_NAME = "maxAge";
+const std::string ONLY_IF_CHANGED_ATTRIBUTE_NAME = "onlyIfChanged";
+
+// Maximum age of a client variable update that onlyIfChanged compares with
+const sup::dto::uint64 ONLY_IF_CHANGED_MAX_AGE_NS = 10000000000;  // 10 seconds
+
+/**
+ * @brief What a client variable exposes of its channel.
+ */
+enum class ClientMode
+{
+  kMonitor,     // Value of the channel, updated by a subscription
+  kConnection,  // Connection state of the channel only
+  kGet          // Value of the channel, fetched when it is read
+};
+
+/**
+ * @brief Assign a value that is no longer needed by the caller to an output parameter.
+ *
+ * @details When the output parameter is still empty, the value is moved into it, which avoids
+ * copying large arrays. Otherwise, this function behaves as sup::dto::TryAssign.
+ *
+ * @param dest Output parameter.
+ * @param src Value to assign.
+ * @return true on success.
+ */
+bool MoveOrAssign(sup::dto::AnyValue& dest, sup::dto::AnyValue&& src);
+
+/**
+ * @brief Check if an attribute string refers to a workspace variable ('@' prefix) instead of
+ * holding a literal value.
+ *
+ * @param attr_str Unprocessed attribute string.
+ * @return true when the attribute is a variable reference.
+ */
+bool IsVariableReference(const std::string& attr_str);
+
+/**
+ * @brief Parse the 'mode' attribute of a client variable.
+ *
+ * @param mode_str Attribute value: "monitor", "connection" or "get".
+ * @param mode Output parameter for the parsed mode.
+ * @return true on successful parsing.
+ */
+bool ParseClientMode(const std::string& mode_str, ClientMode& mode);
+
+/**
+ * @brief Parse a non-negative number of seconds, e.g. from a 'maxAge' or 'timeout' attribute.
+ *
+ * @param seconds_str Attribute value in seconds.
+ * @param duration_ns Output parameter for the parsed duration in nanoseconds.
+ * @return true on successful parsing.
+ */
+bool ParseSeconds(const std::string& seconds_str, sup::dto::uint64& duration_ns);
+
+/**
+ * @brief Convert a non-negative number of seconds to nanoseconds.
+ *
+ * @return false for negative values, NaN or values that do not fit in 64 bit nanoseconds.
+ */
+bool SecondsToNanoseconds(sup::dto::float64 seconds, sup::dto::uint64& duration_ns);
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_EPICS_HELPER_H_
@@ -0,0 +1,285 @@
+/******************************************************************************
+* $HeadURL: $
+* $Id: $
+*
+* Project       : CODAC Supervision and Automation (SUP) oac-tree component
+*
+* Description   : Latency histograms of channel updates
+*
+* Author        : Walter Van Herck (IO)
+*
+* Copyright (c) : 2010-2026 ITER Organization,
+*                 CS 90 046
+*                 13067 St. Paul-lez-Durance Cedex
+*                 France
+* SPDX-License-Identifier: MIT
+*
+* This file is part of ITER CODAC software.
+* For the terms and conditions of redistribution or use of this software
+* refer to the file LICENSE located in the top level directory
+* of the distribution package.
+******************************************************************************/
+#include "latency_histogram.h"
+
+#include "live_object_registry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace
+{
+// Number of bits of the linear subdivision of a logarithmic bucket
+const std::size_t SUB_BUCKET_BITS = 4;
+
+using ChannelLatencyRegistry =
+  sup::oac_tree::epics_helper::LiveObjectRegistry<sup::oac_tree::epics_helper::ChannelLatency>;
+
+ChannelLatencyRegistry& GetChannelLatencyRegistry();
+
+std::size_t MostSignificantBit(sup::dto::uint64 value);
+
+void WriteHistogram(std::ostream& out, const sup::oac_tree::epics_helper::LatencyHistogram& hist);
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+static_assert(LatencyHistogram::LATENCY_SUB_BUCKETS == (1u << SUB_BUCKET_BITS),
+              "Sub-buckets must correspond to the number of sub-bucket bits");
+
+sup::dto::uint64 LatencyClock()
+{
+  auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+}
+
+LatencyHistogram::LatencyHistogram()
+  : m_counts{}
+  , m_count{0}
+  , m_max{0}
+{
+  for (auto& count : m_counts)
+  {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+LatencyHistogram::~LatencyHistogram() = default;
+
+void LatencyHistogram::Record(sup::dto::uint64 latency_ns)
+{
+  (void)m_counts[BucketIndex(latency_ns)].fetch_add(1, std::memory_order_relaxed);
+  (void)m_count.fetch_add(1, std::memory_order_relaxed);
+  auto max = m_max.load(std::memory_order_relaxed);
+  while (latency_ns > max &&
+         !m_max.compare_exchange_weak(max, latency_ns, std::memory_order_relaxed))
+  {}
+}
+
+sup::dto::uint64 LatencyHistogram::GetCount() const
+{
+  return m_count.load(std::memory_order_relaxed);
+}
+
+sup::dto::uint64 LatencyHistogram::GetMax() const
+{
+  return m_max.load(std::memory_order_relaxed);
+}
+
+sup::dto::uint64 LatencyHistogram::GetValueAtPercentile(double percentile) const
+{
+  // Sum the buckets instead of using m_count, which may be updated concurrently
+  sup::dto::uint64 total = 0;
+  for (const auto& count : m_counts)
+  {
+    total += count.load(std::memory_order_relaxed);
+  }
+  if (total == 0)
+  {
+    return 0;
+  }
+  auto rank = static_cast<sup::dto::uint64>(percentile / 100.0 * static_cast<double>(total));
+  rank = std::min(std::max(rank, sup::dto::uint64{1}), total);
+  sup::dto::uint64 cumulative = 0;
+  for (std::size_t idx = 0; idx < LATENCY_BUCKETS; ++idx)
+  {
+    cumulative += m_counts[idx].load(std::memory_order_relaxed);
+    if (cumulative >= rank)
+    {
+      return std::min(BucketUpperBound(idx), GetMax());
+    }
+  }
+  return GetMax();
+}
+
+std::vector<std::pair<sup::dto::uint64, sup::dto::uint64>> LatencyHistogram::GetBuckets() const
+{
+  std::vector<std::pair<sup::dto::uint64, sup::dto::uint64>> result;
+  for (std::size_t idx = 0; idx < LATENCY_BUCKETS; ++idx)
+  {
+    auto count = m_counts[idx].load(std::memory_order_relaxed);
+    if (count != 0)
+    {
+      result.emplace_back(BucketUpperBound(idx), count);
+    }
+  }
+  return result;
+}
+
+std::size_t LatencyHistogram::BucketIndex(sup::dto::uint64 latency_ns)
+{
+  if (latency_ns < LATENCY_SUB_BUCKETS)
+  {
+    return static_cast<std::size_t>(latency_ns);
+  }
+  auto msb = MostSignificantBit(latency_ns);
+  if (msb >= LATENCY_MAX_BITS)
+  {
+    return LATENCY_BUCKETS - 1;
+  }
+  auto sub_bucket = (latency_ns >> (msb - SUB_BUCKET_BITS)) & (LATENCY_SUB_BUCKETS - 1);
+  return (msb - SUB_BUCKET_BITS + 1) * LATENCY_SUB_BUCKETS + static_cast<std::size_t>(sub_bucket);
+}
+
+sup::dto::uint64 LatencyHistogram::BucketUpperBound(std::size_t index)
+{
+  if (index < LATENCY_SUB_BUCKETS)
+  {
+    return index;
+  }
+  auto msb = index / LATENCY_SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+  sup::dto::uint64 sub_bucket = index % LATENCY_SUB_BUCKETS;
+  auto lower = (sup::dto::uint64{1} << msb) | (sub_bucket << (msb - SUB_BUCKET_BITS));
+  return lower + (sup::dto::uint64{1} << (msb - SUB_BUCKET_BITS)) - 1;
+}
+
+ChannelLatency::ChannelLatency(const std::string& variable_type, const std::string& channel)
+  : m_variable_type{variable_type}
+  , m_channel{channel}
+  , m_source_latency{}
+  , m_processing_latency{}
+  , m_clock_skew_count{0}
+{}
+
+ChannelLatency::~ChannelLatency() = default;
+
+void ChannelLatency::RecordUpdate(sup::dto::uint64 source_timestamp,
+                                  sup::dto::uint64 receipt_time,
+                                  sup::dto::uint64 notified_time)
+{
+  if (source_timestamp != 0)
+  {
+    if (source_timestamp > receipt_time)
+    {
+      (void)m_clock_skew_count.fetch_add(1, std::memory_order_relaxed);
+      m_source_latency.Record(0);
+    }
+    else
+    {
+      m_source_latency.Record(receipt_time - source_timestamp);
+    }
+  }
+  m_processing_latency.Record(notified_time > receipt_time ? notified_time - receipt_time : 0);
+}
+
+const std::string& ChannelLatency::GetVariableType() const
+{
+  return m_variable_type;
+}
+
+const std::string& ChannelLatency::GetChannel() const
+{
+  return m_channel;
+}
+
+const LatencyHistogram& ChannelLatency::GetSourceLatency() const
+{
+  return m_source_latency;
+}
+
+const LatencyHistogram& ChannelLatency::GetProcessingLatency() const
+{
+  return m_processing_latency;
+}
+
+sup::dto::uint64 ChannelLatency::GetClockSkewCount() const
+{
+  return m_clock_skew_count.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<ChannelLatency> CreateChannelLatency(const std::string& variable_type,
+                                                     const std::string& channel)
+{
+  auto latency = std::make_shared<ChannelLatency>(variable_type, channel);
+  GetChannelLatencyRegistry().Add(latency);
+  return latency;
+}
+
+std::vector<std::shared_ptr<const ChannelLatency>> GetChannelLatencies()
+{
+  return GetChannelLatencyRegistry().GetAll();
+}
+
+bool AppendChannelLatency(const ChannelLatency& latency, const std::string& filename)
+{
+  std::ofstream out{filename, std::ios::out | std::ios::app};
+  if (!out)
+  {
+    return false;
+  }
+  // Channel names and variable types are not escaped: they do not contain quotes in practice
+  out << R"({"type":")" << latency.GetVariableType() << R"(","channel":")"
+      << latency.GetChannel() << R"(","clock_skew":)" << latency.GetClockSkewCount()
+      << R"(,"source":)";
+  WriteHistogram(out, latency.GetSourceLatency());
+  out << R"(,"processing":)";
+  WriteHistogram(out, latency.GetProcessingLatency());
+  out << "}\n";
+  return static_cast<bool>(out);
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+namespace
+{
+ChannelLatencyRegistry& GetChannelLatencyRegistry()
+{
+  static ChannelLatencyRegistry registry;
+  return registry;
+}
+
+std::size_t MostSignificantBit(sup::dto::uint64 value)
+{
+  std::size_t result = 0;
+  while (value >>= 1)
+  {
+    ++result;
+  }
+  return result;
+}
+
+void WriteHistogram(std::ostream& out, const sup::oac_tree::epics_helper::LatencyHistogram& hist)
+{
+  out << R"({"count":)" << hist.GetCount()
+      << R"(,"p50_ns":)" << hist.GetValueAtPercentile(50.0)
+      << R"(,"p90_ns":)" << hist.GetValueAtPercentile(90.0)
+      << R"(,"p99_ns":)" << hist.GetValueAtPercentile(99.0)
+      << R"(,"p99.9_ns":)" << hist.GetValueAtPercentile(99.9)
+      << R"(,"max_ns":)" << hist.GetMax() << R"(,"buckets":[)";
+  bool first = true;
+  for (const auto& bucket : hist.GetBuckets())
+  {
+    out << (first ? "" : ",") << "[" << bucket.first << "," << bucket.second << "]";
+    first = false;
+  }
+  out << "]}";
+}
+}  // unnamed namespace
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Latency histograms of channel updates
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_LATENCY_HISTOGRAM_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_LATENCY_HISTOGRAM_H_
+
+#include "variable_statistics.h"
+
+#include <sup/dto/anyvalue.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Name of the optional attribute that enables latency measurements of client variables.
+ * Its value is the file to which the histograms are appended on teardown.
+ */
+const std::string LATENCY_FILE_ATTRIBUTE_NAME = "latencyFile";
+
+/**
+ * @brief Current time in nanoseconds since the UNIX epoch, the reference of EPICS timestamps as
+ * provided by sup-epics.
+ */
+sup::dto::uint64 LatencyClock();
+
+/**
+ * @brief Histogram of latencies in nanoseconds with logarithmic buckets, each subdivided in
+ * linear sub-buckets (as in HDR histograms). The relative error of a recorded value is below
+ * 1/LATENCY_SUB_BUCKETS; latencies above about 18 minutes are counted in the last bucket.
+ *
+ * @note Recording and reading can happen concurrently, without locking.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr std::size_t LATENCY_SUB_BUCKETS = 16;
+  static constexpr std::size_t LATENCY_MAX_BITS = 40;
+  static constexpr std::size_t LATENCY_BUCKETS = (LATENCY_MAX_BITS - 3) * LATENCY_SUB_BUCKETS;
+
+  LatencyHistogram();
+  ~LatencyHistogram();
+
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  void Record(sup::dto::uint64 latency_ns);
+
+  sup::dto::uint64 GetCount() const;
+  sup::dto::uint64 GetMax() const;
+
+  /**
+   * @brief Value below which the given percentage of the recorded latencies fall, with the
+   * resolution of the buckets (highest value of the bucket). Zero when nothing was recorded.
+   */
+  sup::dto::uint64 GetValueAtPercentile(double percentile) const;
+
+  /**
+   * @brief Non-empty buckets as pairs of the highest value of the bucket and its count.
+   */
+  std::vector<std::pair<sup::dto::uint64, sup::dto::uint64>> GetBuckets() const;
+
+  static std::size_t BucketIndex(sup::dto::uint64 latency_ns);
+  static sup::dto::uint64 BucketUpperBound(std::size_t index);
+
+private:
+  std::array<std::atomic<sup::dto::uint64>, LATENCY_BUCKETS> m_counts;
+  std::atomic<sup::dto::uint64> m_count;
+  std::atomic<sup::dto::uint64> m_max;
+};
+
+/**
+ * @brief Latencies of the updates of a channel, separating the time from processing on the
+ * IOC/server (EPICS timestamp) to receipt by the plugin from the time the plugin takes to
+ * convert the update and notify the workspace.
+ */
+class alignas(CACHE_LINE_SIZE) ChannelLatency
+{
+public:
+  ChannelLatency(const std::string& variable_type, const std::string& channel);
+  ~ChannelLatency();
+
+  ChannelLatency(const ChannelLatency&) = delete;
+  ChannelLatency& operator=(const ChannelLatency&) = delete;
+
+  /**
+   * @brief Record the latencies of an update.
+   *
+   * @param source_timestamp EPICS timestamp of the update (ns since UNIX epoch) or zero when the
+   * update has no timestamp, in which case only the processing latency is recorded.
+   * @param receipt_time Time the update was received by the plugin (see LatencyClock).
+   * @param notified_time Time the workspace returned from the notification of the update.
+   */
+  void RecordUpdate(sup::dto::uint64 source_timestamp, sup::dto::uint64 receipt_time,
+                    sup::dto::uint64 notified_time);
+
+  const std::string& GetVariableType() const;
+  const std::string& GetChannel() const;
+
+  /**
+   * @brief Latency from the EPICS timestamp to receipt: network and IOC/server processing.
+   */
+  const LatencyHistogram& GetSourceLatency() const;
+
+  /**
+   * @brief Latency from receipt to the return of the workspace notification.
+   */
+  const LatencyHistogram& GetProcessingLatency() const;
+
+  /**
+   * @brief Number of updates whose timestamp lies in the future of their receipt time, which
+   * indicates unsynchronized clocks. Their source latency is counted as zero.
+   */
+  sup::dto::uint64 GetClockSkewCount() const;
+
+private:
+  const std::string m_variable_type;
+  const std::string m_channel;
+  LatencyHistogram m_source_latency;
+  LatencyHistogram m_processing_latency;
+  std::atomic<sup::dto::uint64> m_clock_skew_count;
+};
+
+/**
+ * @brief Create latency histograms for a channel and register them, so they are listed by
+ * GetChannelLatencies while the returned pointer (or a copy of it) is alive.
+ */
+std::shared_ptr<ChannelLatency> CreateChannelLatency(const std::string& variable_type,
+                                                     const std::string& channel);
+
+/**
+ * @brief Latency histograms of all channels that currently measure them.
+ */
+std::vector<std::shared_ptr<const ChannelLatency>> GetChannelLatencies();
+
+/**
+ * @brief Append the latency histograms of a channel as a single line JSON object to a file.
+ *
+ * @return true on success.
+ */
+bool AppendChannelLatency(const ChannelLatency& latency, const std::string& filename);
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,51 @@
+/******************************************************************************
+* $HeadURL: $
+* $Id: $
+*
+* Project       : CODAC Supervision and Automation (SUP) oac-tree component
+*
+* Description   : Channels of client variables created on first use
+*
+* Author        : Walter Van Herck (IO)
+*
+* Copyright (c) : 2010-2026 ITER Organization,
+*                 CS 90 046
+*                 13067 St. Paul-lez-Durance Cedex
+*                 France
+* SPDX-License-Identifier: MIT
+*
+* This file is part of ITER CODAC software.
+* For the terms and conditions of redistribution or use of this software
+* refer to the file LICENSE located in the top level directory
+* of the distribution package.
+******************************************************************************/
+
+#include "lazy_channel.h"
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+bool ParseConnectMode(const std::string& connect_str, bool& lazy)
+{
+  if (connect_str == CONNECT_EAGER)
+  {
+    lazy = false;
+    return true;
+  }
+  if (connect_str == CONNECT_LAZY)
+  {
+    lazy = true;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Channels of client variables created on first use
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_LAZY_CHANNEL_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_LAZY_CHANNEL_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+const std::string CONNECT_ATTRIBUTE_NAME = "connect";
+const std::string CONNECT_EAGER = "eager";
+const std::string CONNECT_LAZY = "lazy";
+
+// Maximum time the access that creates a deferred channel waits for it to connect
+const double FIRST_ACCESS_TIMEOUT_SEC = 2.0;
+
+/**
+ * @brief Parse the 'connect' attribute of a client variable.
+ *
+ * @param connect_str Attribute value: "eager" or "lazy".
+ * @param lazy Output parameter, set to true for lazy connection.
+ * @return true on successful parsing.
+ */
+bool ParseConnectMode(const std::string& connect_str, bool& lazy);
+
+/**
+ * @brief Channel of a client variable that is either created immediately or deferred until it is
+ * first accessed.
+ *
+ * @details Deferring the creation avoids the search, connection and subscription for variables
+ * that are declared but never used. Get() is cheap once the channel exists: a single atomic load
+ * on top of the pointer access. GetConnected() additionally lets the access that creates the
+ * channel wait for its connection, which requires PV::WaitForConnected(double).
+ */
+template <typename PV>
+class LazyChannel
+{
+public:
+  using Factory = std::function<std::unique_ptr<PV>()>;
+
+  LazyChannel()
+    : m_pending{false}
+    , m_mtx{}
+    , m_factory{}
+    , m_pv{}
+  {}
+  ~LazyChannel() = default;
+
+  LazyChannel(const LazyChannel&) = delete;
+  LazyChannel& operator=(const LazyChannel&) = delete;
+
+  /**
+   * @brief Create the channel now (eager) or on the first call to Get (lazy).
+   */
+  void Create(Factory factory, bool lazy)
+  {
+    Reset();
+    if (!lazy)
+    {
+      m_pv = factory();
+      return;
+    }
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_factory = std::move(factory);
+    m_pending.store(true, std::memory_order_release);
+  }
+
+  /**
+   * @brief Get the channel, creating it first when its creation was deferred.
+   *
+   * @return Channel or nullptr when no channel was created.
+   */
+  PV* Get()
+  {
+    if (m_pending.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lk{m_mtx};
+      if (m_pending.load(std::memory_order_relaxed))
+      {
+        m_pv = m_factory();
+        m_factory = nullptr;
+        m_pending.store(false, std::memory_order_release);
+      }
+    }
+    return m_pv.get();
+  }
+
+  /**
+   * @brief Get the channel like Get(), but when this call creates the channel, wait at most the
+   * given time for it to connect, so the first access to a deferred channel can succeed.
+   *
+   * @note Other threads accessing the channel meanwhile do not wait and may find it disconnected.
+   */
+  PV* GetConnected(double timeout_sec)
+  {
+    PV* created = nullptr;
+    if (m_pending.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lk{m_mtx};
+      if (m_pending.load(std::memory_order_relaxed))
+      {
+        m_pv = m_factory();
+        m_factory = nullptr;
+        m_pending.store(false, std::memory_order_release);
+        created = m_pv.get();
+      }
+    }
+    if (created != nullptr)
+    {
+      (void)created->WaitForConnected(timeout_sec);
+    }
+    return m_pv.get();
+  }
+
+  /**
+   * @brief Check if the creation of the channel is still deferred.
+   */
+  bool IsPending() const
+  {
+    return m_pending.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Destroy the channel or drop its deferred creation.
+   */
+  void Reset()
+  {
+    {
+      std::lock_guard<std::mutex> lk{m_mtx};
+      m_pending.store(false, std::memory_order_relaxed);
+      m_factory = nullptr;
+    }
+    m_pv.reset();
+  }
+
+private:
+  std::atomic<bool> m_pending;
+  std::mutex m_mtx;
+  Factory m_factory;
+  std::unique_ptr<PV> m_pv;
+};
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_LAZY_CHANNEL_H_
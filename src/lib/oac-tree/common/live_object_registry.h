@@ -0,0 +1,103 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Registry of objects shared with variables
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_LIVE_OBJECT_REGISTRY_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_LIVE_OBJECT_REGISTRY_H_
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Thread safe registry of objects that are shared with variables, like their statistics.
+ * Entries are weak references, so variables never need to unregister.
+ */
+template <typename T>
+class LiveObjectRegistry
+{
+public:
+  LiveObjectRegistry()
+    : m_mtx{}
+    , m_entries{}
+    , m_prune_size{1}
+  {}
+
+  ~LiveObjectRegistry() = default;
+
+  void Add(const std::shared_ptr<T>& object)
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    // Amortized cleanup: entries of variables that were torn down are dropped when the registry
+    // doubled in size since the last cleanup
+    if (m_entries.size() >= 2 * m_prune_size)
+    {
+      RemoveExpired();
+      m_prune_size = std::max(m_entries.size(), std::size_t{1});
+    }
+    m_entries.push_back(object);
+  }
+
+  std::vector<std::shared_ptr<const T>> GetAll()
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    RemoveExpired();
+    std::vector<std::shared_ptr<const T>> result;
+    result.reserve(m_entries.size());
+    for (const auto& entry : m_entries)
+    {
+      if (auto object = entry.lock())
+      {
+        result.push_back(std::move(object));
+      }
+    }
+    return result;
+  }
+
+private:
+  void RemoveExpired()
+  {
+    auto expired = [](const std::weak_ptr<const T>& entry) {
+      return entry.expired();
+    };
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), expired), m_entries.end());
+  }
+
+  std::mutex m_mtx;
+  std::vector<std::weak_ptr<const T>> m_entries;
+  std::size_t m_prune_size;
+};
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_LIVE_OBJECT_REGISTRY_H_
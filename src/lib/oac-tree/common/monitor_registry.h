@@ -0,0 +1,230 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Registry of values received by channel monitors
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_MONITOR_REGISTRY_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_MONITOR_REGISTRY_H_
+
+#include <sup/dto/anytype.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Live monitor of a channel, published by a client variable so that instructions can
+ * read its last value instead of accessing the channel themselves.
+ *
+ * @details The owner records the receipt time of each update (zero when disconnected). The value
+ * itself is only retrieved, through the getter, when it is requested and recent enough. The owner
+ * calls Close before destroying the channel the getter refers to.
+ */
+template <typename Value>
+class MonitoredChannel
+{
+public:
+  using Getter = std::function<Value()>;
+
+  explicit MonitoredChannel(Getter getter)
+    : m_mtx{}
+    , m_getter{std::move(getter)}
+    , m_last_update{0}
+  {}
+  ~MonitoredChannel() = default;
+
+  MonitoredChannel(const MonitoredChannel&) = delete;
+  MonitoredChannel& operator=(const MonitoredChannel&) = delete;
+
+  /**
+   * @brief Record the receipt time of an update in nanoseconds since the epoch, or zero when the
+   * channel disconnected.
+   */
+  void SetLastUpdate(sup::dto::uint64 update_ns)
+  {
+    m_last_update.store(update_ns, std::memory_order_release);
+  }
+
+  /**
+   * @brief Get the value if the last update was received at most max_age_ns before now_ns.
+   *
+   * @return true when the value was retrieved.
+   */
+  bool GetValue(sup::dto::uint64 max_age_ns, sup::dto::uint64 now_ns, Value& value) const
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    auto last_update = m_last_update.load(std::memory_order_acquire);
+    bool too_old = now_ns > last_update && now_ns - last_update > max_age_ns;
+    if (!m_getter || last_update == 0 || too_old)
+    {
+      return false;
+    }
+    value = m_getter();
+    return true;
+  }
+
+  /**
+   * @brief Stop providing values. Waits for a running call of the getter to finish.
+   */
+  void Close()
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_getter = nullptr;
+    m_last_update.store(0, std::memory_order_release);
+  }
+
+private:
+  mutable std::mutex m_mtx;
+  Getter m_getter;
+  std::atomic<sup::dto::uint64> m_last_update;
+};
+
+/**
+ * @brief Registry of the live monitors in the process, by channel name and channel type.
+ *
+ * @details The registry only holds weak references: a monitor is removed when its owner releases
+ * it.
+ * @code
+     // Client variable
+     m_monitored = std::make_shared<MonitoredChannel<Value>>(getter);
+     registry.Register(channel, type, m_monitored);
+     // Instruction
+     Value value;
+     if (registry.GetValue(channel, type, max_age_ns, now_ns, value)) { ... }
+   @endcode
+ */
+template <typename Value>
+class MonitorRegistry
+{
+public:
+  MonitorRegistry()
+    : m_mtx{}
+    , m_monitors{}
+    , m_prune_size{1}
+  {}
+  ~MonitorRegistry() = default;
+
+  MonitorRegistry(const MonitorRegistry&) = delete;
+  MonitorRegistry& operator=(const MonitorRegistry&) = delete;
+
+  void Register(const std::string& channel, const sup::dto::AnyType& type,
+                const std::shared_ptr<MonitoredChannel<Value>>& monitor)
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    // Entries of the same channel are dropped right away, as the channel is registered again.
+    // Others only when the registry doubled in size since the last full cleanup (amortized, as in
+    // LiveObjectRegistry).
+    auto range = m_monitors.equal_range(channel);
+    RemoveExpired(range.first, range.second);
+    if (m_monitors.size() >= 2 * m_prune_size)
+    {
+      RemoveExpired(m_monitors.begin(), m_monitors.end());
+      m_prune_size = std::max(m_monitors.size(), std::size_t{1});
+    }
+    m_monitors.emplace(channel, Entry{type, monitor});
+  }
+
+  /**
+   * @brief Get the value of a monitor of the given channel and type, whose last update was
+   * received at most max_age_ns before now_ns.
+   *
+   * @return true when such a monitor provided the value.
+   */
+  bool GetValue(const std::string& channel, const sup::dto::AnyType& type,
+                sup::dto::uint64 max_age_ns, sup::dto::uint64 now_ns, Value& value) const
+  {
+    std::vector<std::shared_ptr<MonitoredChannel<Value>>> candidates;
+    {
+      std::lock_guard<std::mutex> lk{m_mtx};
+      auto range = m_monitors.equal_range(channel);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        auto monitor = it->second.monitor.lock();
+        if (monitor && it->second.type == type)
+        {
+          candidates.push_back(std::move(monitor));
+        }
+      }
+    }
+    for (const auto& monitor : candidates)
+    {
+      if (monitor->GetValue(max_age_ns, now_ns, value))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Number of registered monitors that are still alive.
+   */
+  std::size_t GetSize() const
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    std::size_t result = 0;
+    for (const auto& entry : m_monitors)
+    {
+      result += entry.second.monitor.expired() ? 0 : 1;
+    }
+    return result;
+  }
+
+private:
+  struct Entry
+  {
+    sup::dto::AnyType type;
+    std::weak_ptr<MonitoredChannel<Value>> monitor;
+  };
+  using EntryMap = std::multimap<std::string, Entry>;
+
+  void RemoveExpired(typename EntryMap::iterator first, typename EntryMap::iterator last)
+  {
+    while (first != last)
+    {
+      first = first->second.monitor.expired() ? m_monitors.erase(first) : std::next(first);
+    }
+  }
+
+  mutable std::mutex m_mtx;
+  EntryMap m_monitors;
+  std::size_t m_prune_size;
+};
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_MONITOR_REGISTRY_H_
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Compile-time traits of numeric types
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_NUMERIC_TRAITS_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_NUMERIC_TRAITS_H_
+
+#include <sup/dto/anyvalue.h>
+
+#include <limits>
+#include <type_traits>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Check if every value of the numeric type S can be represented exactly in the numeric
+ * type D. Identical types are not considered a conversion.
+ */
+template <typename S, typename D>
+constexpr bool IsLosslessNumeric()
+{
+  if (std::is_same<S, D>::value)
+  {
+    return false;
+  }
+  if (std::is_integral<S>::value && std::is_integral<D>::value)
+  {
+    return sizeof(D) > sizeof(S) && (std::is_signed<D>::value || !std::is_signed<S>::value);
+  }
+  if (std::is_integral<S>::value)
+  {
+    return std::numeric_limits<S>::digits <= std::numeric_limits<D>::digits;
+  }
+  return std::is_floating_point<D>::value && sizeof(D) > sizeof(S);
+}
+
+/**
+ * @brief Type code of a boolean or numeric C++ type.
+ */
+template <typename T>
+constexpr sup::dto::TypeCode TypeCodeOf()
+{
+  if constexpr (std::is_same<T, sup::dto::boolean>::value)
+  {
+    return sup::dto::TypeCode::Bool;
+  }
+  else if constexpr (std::is_floating_point<T>::value)
+  {
+    return sizeof(T) == 4 ? sup::dto::TypeCode::Float32 : sup::dto::TypeCode::Float64;
+  }
+  else if constexpr (std::is_signed<T>::value)
+  {
+    return sizeof(T) == 1   ? sup::dto::TypeCode::Int8
+           : sizeof(T) == 2 ? sup::dto::TypeCode::Int16
+           : sizeof(T) == 4 ? sup::dto::TypeCode::Int32
+                            : sup::dto::TypeCode::Int64;
+  }
+  else
+  {
+    return sizeof(T) == 1   ? sup::dto::TypeCode::UInt8
+           : sizeof(T) == 2 ? sup::dto::TypeCode::UInt16
+           : sizeof(T) == 4 ? sup::dto::TypeCode::UInt32
+                            : sup::dto::TypeCode::UInt64;
+  }
+}
+
+/**
+ * @brief Empty object carrying a C++ type, used to dispatch on sup::dto type codes.
+ */
+template <typename T>
+struct TypeTag
+{
+  using type = T;
+};
+
+/**
+ * @brief Call 'func' with the TypeTag of the numeric type corresponding to 'type_code'.
+ *
+ * @return Result of 'func' or 'fallback' when 'type_code' does not denote a numeric type.
+ */
+template <typename F, typename R>
+R DispatchNumericType(sup::dto::TypeCode type_code, F&& func, R fallback)
+{
+  switch (type_code)
+  {
+  case sup::dto::TypeCode::Int8:
+    return func(TypeTag<sup::dto::int8>{});
+  case sup::dto::TypeCode::UInt8:
+    return func(TypeTag<sup::dto::uint8>{});
+  case sup::dto::TypeCode::Int16:
+    return func(TypeTag<sup::dto::int16>{});
+  case sup::dto::TypeCode::UInt16:
+    return func(TypeTag<sup::dto::uint16>{});
+  case sup::dto::TypeCode::Int32:
+    return func(TypeTag<sup::dto::int32>{});
+  case sup::dto::TypeCode::UInt32:
+    return func(TypeTag<sup::dto::uint32>{});
+  case sup::dto::TypeCode::Int64:
+    return func(TypeTag<sup::dto::int64>{});
+  case sup::dto::TypeCode::UInt64:
+    return func(TypeTag<sup::dto::uint64>{});
+  case sup::dto::TypeCode::Float32:
+    return func(TypeTag<sup::dto::float32>{});
+  case sup::dto::TypeCode::Float64:
+    return func(TypeTag<sup::dto::float64>{});
+  default:
+    break;
+  }
+  return fallback;
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_NUMERIC_TRAITS_H_
@@ -0,0 +1,150 @@
+/******************************************************************************
+* $HeadURL: $
+* $Id: $
+*
+* Project       : CODAC Supervision and Automation (SUP) oac-tree component
+*
+* Description   : Diagnostic counters of the EPICS plugins
+*
+* Author        : Walter Van Herck (IO)
+*
+* Copyright (c) : 2010-2026 ITER Organization,
+*                 CS 90 046
+*                 13067 St. Paul-lez-Durance Cedex
+*                 France
+* SPDX-License-Identifier: MIT
+*
+* This file is part of ITER CODAC software.
+* For the terms and conditions of redistribution or use of this software
+* refer to the file LICENSE located in the top level directory
+* of the distribution package.
+******************************************************************************/
+
+#include "plugin_diagnostics.h"
+
+#include "connection_scheduler.h"
+#include "variable_statistics.h"
+
+#include <atomic>
+
+namespace
+{
+// Variable types of the Channel Access plugin share this prefix
+const std::string CA_VARIABLE_TYPE_PREFIX = "ChannelAccess";
+
+std::atomic<sup::dto::uint32>& CallbacksInProgress();
+
+std::atomic<sup::dto::uint32>& OutstandingRPCs();
+
+std::atomic<sup::dto::uint64>& SkippedWrites();
+
+std::atomic<sup::dto::uint64>& PrefetchedChannels();
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+PluginDiagnostics CollectPluginDiagnostics()
+{
+  PluginDiagnostics result{};
+  for (const auto& statistics : GetVariableStatistics())
+  {
+    const auto& variable_type = statistics->GetVariableType();
+    if (variable_type.compare(0, CA_VARIABLE_TYPE_PREFIX.size(), CA_VARIABLE_TYPE_PREFIX) == 0)
+    {
+      ++result.ca_channels;
+    }
+    else
+    {
+      ++result.pva_channels;
+    }
+    auto snapshot = statistics->GetSnapshot();
+    if (snapshot.connected)
+    {
+      ++result.connected;
+    }
+    else
+    {
+      ++result.disconnected;
+    }
+    result.updates_received += snapshot.updates_received;
+    result.notify_count += snapshot.notify_count;
+    result.conversion_failures += snapshot.conversion_failures;
+  }
+  result.callbacks_in_progress = CallbacksInProgress().load(std::memory_order_relaxed);
+  result.outstanding_rpcs = OutstandingRPCs().load(std::memory_order_relaxed);
+  auto scheduler_snapshot = GetConnectionScheduler().GetSnapshot();
+  result.pending_connections = scheduler_snapshot.pending;
+  result.time_to_all_connected = scheduler_snapshot.time_to_all_connected;
+  result.pending_since = scheduler_snapshot.pending_since;
+  result.skipped_writes = SkippedWrites().load(std::memory_order_relaxed);
+  result.prefetched_channels = PrefetchedChannels().load(std::memory_order_relaxed);
+  return result;
+}
+
+void RecordSkippedWrite()
+{
+  (void)SkippedWrites().fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecordPrefetchedChannel()
+{
+  (void)PrefetchedChannels().fetch_add(1, std::memory_order_relaxed);
+}
+
+ActiveCallbackGuard::ActiveCallbackGuard()
+{
+  (void)CallbacksInProgress().fetch_add(1, std::memory_order_relaxed);
+}
+
+ActiveCallbackGuard::~ActiveCallbackGuard()
+{
+  (void)CallbacksInProgress().fetch_sub(1, std::memory_order_relaxed);
+}
+
+OutstandingRPCGuard::OutstandingRPCGuard()
+{
+  (void)OutstandingRPCs().fetch_add(1, std::memory_order_relaxed);
+}
+
+OutstandingRPCGuard::~OutstandingRPCGuard()
+{
+  (void)OutstandingRPCs().fetch_sub(1, std::memory_order_relaxed);
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+namespace
+{
+std::atomic<sup::dto::uint32>& CallbacksInProgress()
+{
+  static std::atomic<sup::dto::uint32> counter{0};
+  return counter;
+}
+
+std::atomic<sup::dto::uint32>& OutstandingRPCs()
+{
+  static std::atomic<sup::dto::uint32> counter{0};
+  return counter;
+}
+
+std::atomic<sup::dto::uint64>& SkippedWrites()
+{
+  static std::atomic<sup::dto::uint64> counter{0};
+  return counter;
+}
+
+std::atomic<sup::dto::uint64>& PrefetchedChannels()
+{
+  static std::atomic<sup::dto::uint64> counter{0};
+  return counter;
+}
+}  // unnamed namespace
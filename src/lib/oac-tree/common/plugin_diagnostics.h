@@ -0,0 +1,109 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Diagnostic counters of the EPICS plugins
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_PLUGIN_DIAGNOSTICS_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_PLUGIN_DIAGNOSTICS_H_
+
+#include <sup/dto/anyvalue.h>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Aggregated health of the EPICS plugins in the current process.
+ */
+struct PluginDiagnostics
+{
+  sup::dto::uint32 ca_channels;
+  sup::dto::uint32 pva_channels;
+  sup::dto::uint32 connected;
+  sup::dto::uint32 disconnected;
+  sup::dto::uint64 updates_received;
+  sup::dto::uint64 notify_count;
+  sup::dto::uint64 conversion_failures;
+  sup::dto::uint32 callbacks_in_progress;
+  sup::dto::uint32 outstanding_rpcs;
+  sup::dto::uint64 pending_connections;
+  double time_to_all_connected;
+  double pending_since;
+  sup::dto::uint64 skipped_writes;
+  sup::dto::uint64 prefetched_channels;
+};
+
+/**
+ * @brief Collect the diagnostics from the statistics of all variables that are set up, from
+ * the process-wide callback, RPC, write and channel counters and from the connection scheduler.
+ */
+PluginDiagnostics CollectPluginDiagnostics();
+
+/**
+ * @brief Count a write instruction that skipped its put, because the channel already had the
+ * value to write.
+ */
+void RecordSkippedWrite();
+
+/**
+ * @brief Count an instruction execution that used the channel created during procedure setup.
+ */
+void RecordPrefetchedChannel();
+
+/**
+ * @brief Marks the execution of a monitor callback of a variable for the lifetime of the guard.
+ *
+ * @details The callbacks are queued and dispatched by the EPICS client libraries, which do not
+ * expose their queues. The number of callbacks in progress is the part of that backlog that
+ * is visible to the plugins: it grows when variable updates are slow to handle.
+ */
+class ActiveCallbackGuard
+{
+public:
+  ActiveCallbackGuard();
+  ~ActiveCallbackGuard();
+
+  ActiveCallbackGuard(const ActiveCallbackGuard&) = delete;
+  ActiveCallbackGuard& operator=(const ActiveCallbackGuard&) = delete;
+};
+
+/**
+ * @brief Marks an RPC call that was sent and whose reply was not yet received.
+ */
+class OutstandingRPCGuard
+{
+public:
+  OutstandingRPCGuard();
+  ~OutstandingRPCGuard();
+
+  OutstandingRPCGuard(const OutstandingRPCGuard&) = delete;
+  OutstandingRPCGuard& operator=(const OutstandingRPCGuard&) = delete;
+};
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_PLUGIN_DIAGNOSTICS_H_
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Channels created during instruction setup
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_PREFETCHED_CHANNEL_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_PREFETCHED_CHANNEL_H_
+
+#include "plugin_diagnostics.h"
+
+#include <sup/dto/anytype.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Holds the channel that an instruction created during setup until its first execution.
+ *
+ * @details Instructions with a literal channel name create their channel during procedure setup
+ * and store it here, so their first execution finds a channel that is already connected. A stored
+ * channel is only handed out for the same channel name and type.
+ *
+ * @code
+     auto pv = prefetched.Take(channel, type);
+     if (!pv)
+     {
+       pv = CreatePV(channel, type);
+     }
+   @endcode
+ */
+template <typename PV>
+class PrefetchedChannel
+{
+public:
+  PrefetchedChannel()
+    : m_mtx{}
+    , m_enabled{false}
+    , m_channel{}
+    , m_type{}
+    , m_pv{}
+  {}
+  ~PrefetchedChannel() = default;
+
+  PrefetchedChannel(const PrefetchedChannel&) = delete;
+  PrefetchedChannel& operator=(const PrefetchedChannel&) = delete;
+
+  /**
+   * @brief Enable or disable keeping channels. Disabling destroys any stored channel.
+   */
+  void SetEnabled(bool enabled)
+  {
+    std::unique_ptr<PV> discarded;
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_enabled = enabled;
+    if (!m_enabled)
+    {
+      discarded = ClearLocked();
+    }
+  }
+
+  bool IsEnabled() const
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    return m_enabled;
+  }
+
+  /**
+   * @brief Store a channel for later use. When disabled, the channel is destroyed instead.
+   */
+  void Store(const std::string& channel, const sup::dto::AnyType& type, std::unique_ptr<PV> pv)
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    if (!m_enabled || !pv)
+    {
+      return;
+    }
+    std::swap(m_pv, pv);
+    m_channel = channel;
+    m_type = type;
+  }
+
+  /**
+   * @brief Destroy the stored channel, if any, without disabling.
+   */
+  void Clear()
+  {
+    std::unique_ptr<PV> discarded;
+    std::lock_guard<std::mutex> lk{m_mtx};
+    discarded = ClearLocked();
+  }
+
+  /**
+   * @brief Take the stored channel if it matches the given name and type.
+   *
+   * @return Stored channel or nullptr. A stored channel that does not match is destroyed.
+   * Handing out a stored channel is counted in the 'prefetched_channels' diagnostics.
+   */
+  std::unique_ptr<PV> Take(const std::string& channel, const sup::dto::AnyType& type)
+  {
+    std::unique_ptr<PV> discarded;
+    std::lock_guard<std::mutex> lk{m_mtx};
+    bool matches = m_pv && channel == m_channel && type == m_type;
+    auto pv = ClearLocked();
+    if (!matches)
+    {
+      discarded = std::move(pv);
+      return {};
+    }
+    RecordPrefetchedChannel();
+    return pv;
+  }
+
+private:
+  std::unique_ptr<PV> ClearLocked()
+  {
+    m_channel.clear();
+    m_type = sup::dto::EmptyType;
+    return std::move(m_pv);
+  }
+
+  mutable std::mutex m_mtx;
+  bool m_enabled;
+  std::string m_channel;
+  sup::dto::AnyType m_type;
+  std::unique_ptr<PV> m_pv;
+};
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_PREFETCHED_CHANNEL_H_
@@ -0,0 +1,118 @@
+/******************************************************************************
+* $HeadURL: $
+* $Id: $
+*
+* Project       : CODAC Supervision and Automation (SUP) oac-tree component
+*
+* Description   : Precomputed conversion of scalar values
+*
+* Author        : Walter Van Herck (IO)
+*
+* Copyright (c) : 2010-2026 ITER Organization,
+*                 CS 90 046
+*                 13067 St. Paul-lez-Durance Cedex
+*                 France
+* SPDX-License-Identifier: MIT
+*
+* This file is part of ITER CODAC software.
+* For the terms and conditions of redistribution or use of this software
+* refer to the file LICENSE located in the top level directory
+* of the distribution package.
+******************************************************************************/
+
+#include "scalar_conversion.h"
+
+#include "numeric_traits.h"
+
+#include <sup/dto/anyvalue_helper.h>
+
+namespace
+{
+using sup::oac_tree::epics_helper::ScalarConverter;
+
+template <typename S, typename D>
+sup::dto::AnyValue ConvertScalar(const sup::dto::AnyValue& src);
+
+template <typename S, typename D>
+ScalarConverter SelectScalarConverter();
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+ScalarConverter SelectScalarConverter(sup::dto::TypeCode src_code, sup::dto::TypeCode dest_code)
+{
+  if (src_code == sup::dto::TypeCode::Bool && dest_code == sup::dto::TypeCode::Bool)
+  {
+    return &ConvertScalar<sup::dto::boolean, sup::dto::boolean>;
+  }
+  auto select_for_source = [dest_code](auto src_tag) {
+    using S = typename decltype(src_tag)::type;
+    auto select = [](auto dest_tag) {
+      using D = typename decltype(dest_tag)::type;
+      return ::SelectScalarConverter<S, D>();
+    };
+    return DispatchNumericType(dest_code, select, ScalarConverter{nullptr});
+  };
+  return DispatchNumericType(src_code, select_for_source, ScalarConverter{nullptr});
+}
+
+ScalarConversion::ScalarConversion(const sup::dto::AnyType& dest_type)
+  : m_dest_code{dest_type.GetTypeCode()}
+  , m_src_code{sup::dto::TypeCode::Empty}
+  , m_converter{nullptr}
+{}
+
+ScalarConversion::~ScalarConversion() = default;
+
+sup::dto::AnyValue ScalarConversion::Convert(const sup::dto::AnyValue& src)
+{
+  auto src_code = src.GetTypeCode();
+  if (src_code != m_src_code)
+  {
+    m_converter = SelectScalarConverter(src_code, m_dest_code);
+    m_src_code = src_code;
+  }
+  if (m_converter == nullptr)
+  {
+    return {};
+  }
+  return m_converter(src);
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+namespace
+{
+template <typename S, typename D>
+sup::dto::AnyValue ConvertScalar(const sup::dto::AnyValue& src)
+{
+  if (src.GetTypeCode() != sup::oac_tree::epics_helper::TypeCodeOf<S>())
+  {
+    return {};
+  }
+  return sup::dto::AnyValue{static_cast<D>(src.As<S>())};
+}
+
+template <typename S, typename D>
+ScalarConverter SelectScalarConverter()
+{
+  if constexpr (std::is_same<S, D>::value ||
+                sup::oac_tree::epics_helper::IsLosslessNumeric<S, D>())
+  {
+    return &ConvertScalar<S, D>;
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+}  // unnamed namespace
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Precomputed conversion of scalar values
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_SCALAR_CONVERSION_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_SCALAR_CONVERSION_H_
+
+#include <sup/dto/anyvalue.h>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Function that converts a scalar of a fixed source type to a scalar of a fixed
+ * destination type. It returns an empty value when the source has another type.
+ */
+using ScalarConverter = sup::dto::AnyValue (*)(const sup::dto::AnyValue&);
+
+/**
+ * @brief Select the specialized converter for the given pair of scalar types.
+ *
+ * @details Converters are provided for identical boolean or numeric types and for lossless
+ * numeric conversions (see IsLosslessNumericConversion). They read the native source value and
+ * construct the result directly, bypassing the generic conversion of sup-dto.
+ *
+ * @return Converter or nullptr when the pair requires the generic (range checked) conversion.
+ */
+ScalarConverter SelectScalarConverter(sup::dto::TypeCode src_code, sup::dto::TypeCode dest_code);
+
+/**
+ * @brief Scalar conversion to a fixed destination type, keeping the converter that was selected
+ * for the last source type. Sources of a given channel normally keep the same type, so selection
+ * only happens on the first update.
+ *
+ * @note Not thread safe.
+ */
+class ScalarConversion
+{
+public:
+  explicit ScalarConversion(const sup::dto::AnyType& dest_type = sup::dto::EmptyType);
+  ~ScalarConversion();
+
+  /**
+   * @brief Convert a scalar with the specialized converter.
+   *
+   * @param src Source value.
+   * @return Converted value or empty value when no specialized converter applies, in which case
+   * the generic conversion needs to be used.
+   */
+  sup::dto::AnyValue Convert(const sup::dto::AnyValue& src);
+
+private:
+  sup::dto::TypeCode m_dest_code;
+  sup::dto::TypeCode m_src_code;
+  ScalarConverter m_converter;
+};
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_SCALAR_CONVERSION_H_
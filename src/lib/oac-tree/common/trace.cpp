@@ -0,0 +1,422 @@
+/******************************************************************************
+* $HeadURL: $
+* $Id: $
+*
+* Project       : CODAC Supervision and Automation (SUP) oac-tree component
+*
+* Description   : Tracing of plugin operations
+*
+* Author        : Walter Van Herck (IO)
+*
+* Copyright (c) : 2010-2026 ITER Organization,
+*                 CS 90 046
+*                 13067 St. Paul-lez-Durance Cedex
+*                 France
+* SPDX-License-Identifier: MIT
+*
+* This file is part of ITER CODAC software.
+* For the terms and conditions of redistribution or use of this software
+* refer to the file LICENSE located in the top level directory
+* of the distribution package.
+******************************************************************************/
+#include "trace.h"
+
+#include "variable_statistics.h"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+// Power of two, so that the ring buffer index is a cheap modulo
+const std::size_t TRACE_BUFFER_CAPACITY = 8192;
+const char* const TRACE_CATEGORY = "oac-tree-epics";
+const char SPAN_PHASE = 'X';
+const char INSTANT_PHASE = 'i';
+
+struct TraceEvent
+{
+  const char* name;
+  sup::dto::uint64 start_ns;
+  sup::dto::uint64 duration_ns;
+  char phase;
+};
+
+/**
+ * @brief Lock-free single producer, single consumer queue of the trace events of one thread.
+ * The owning thread pushes events, the thread that flushes pops them under the tracer's lock.
+ * Events are dropped when the buffer is full.
+ */
+class ThreadTraceBuffer
+{
+public:
+  explicit ThreadTraceBuffer(sup::dto::uint32 thread_id);
+  ~ThreadTraceBuffer();
+
+  void Push(const TraceEvent& event);
+
+  template <typename F>
+  void Drain(F&& func);
+
+  sup::dto::uint32 GetThreadId() const;
+  sup::dto::uint64 GetDropped() const;
+  void SetFinished();
+  bool IsFinished() const;
+
+private:
+  std::array<TraceEvent, TRACE_BUFFER_CAPACITY> m_events;
+  alignas(sup::oac_tree::epics_helper::CACHE_LINE_SIZE) std::atomic<sup::dto::uint64> m_head;
+  alignas(sup::oac_tree::epics_helper::CACHE_LINE_SIZE) std::atomic<sup::dto::uint64> m_tail;
+  std::atomic<sup::dto::uint64> m_dropped;
+  std::atomic<bool> m_finished;
+  const sup::dto::uint32 m_thread_id;
+};
+
+/**
+ * @brief Owns the buffers of all threads that recorded events and the trace file.
+ */
+class Tracer
+{
+public:
+  Tracer();
+  ~Tracer();
+
+  std::shared_ptr<ThreadTraceBuffer> RegisterThread();
+  void Open(const std::string& filename);
+  void Close();
+  void Flush();
+  sup::dto::uint64 GetDropped();
+
+private:
+  void FlushImpl();
+  void WriteEvent(const TraceEvent& event, sup::dto::uint32 thread_id);
+  std::mutex m_mtx;
+  std::vector<std::shared_ptr<ThreadTraceBuffer>> m_buffers;
+  std::ofstream m_file;
+  bool m_first_event;
+  sup::dto::uint32 m_next_thread_id;
+  sup::dto::uint64 m_dropped_finished;
+};
+
+/**
+ * @brief Thread local handle to the buffer of a thread, which is registered on first use. The
+ * tracer keeps the buffer alive after the thread exits, until its events are written.
+ */
+class ThreadBufferHandle
+{
+public:
+  ThreadBufferHandle();
+  ~ThreadBufferHandle();
+
+  ThreadTraceBuffer& Get();
+
+private:
+  std::shared_ptr<ThreadTraceBuffer> m_buffer;
+};
+
+Tracer& GetTracer();
+
+void RecordEvent(const TraceEvent& event);
+
+bool EnableTracingFromEnvironment();
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+const std::string TRACE_FILE_ENVIRONMENT_VARIABLE = "OAC_TREE_EPICS_TRACE_FILE";
+
+namespace trace_detail
+{
+std::atomic<bool> tracing_enabled{false};
+
+sup::dto::uint64 TraceClock()
+{
+  auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+}
+
+void RecordSpan(const char* name, sup::dto::uint64 start_ns)
+{
+  auto now = TraceClock();
+  RecordEvent({name, start_ns, now - start_ns, SPAN_PHASE});
+}
+}  // namespace trace_detail
+
+void EnableTracing(const std::string& filename)
+{
+  GetTracer().Open(filename);
+  trace_detail::tracing_enabled.store(true, std::memory_order_relaxed);
+}
+
+void DisableTracing()
+{
+  trace_detail::tracing_enabled.store(false, std::memory_order_relaxed);
+  GetTracer().Close();
+}
+
+void FlushTrace()
+{
+  if (!IsTracingEnabled())
+  {
+    return;
+  }
+  GetTracer().Flush();
+}
+
+sup::dto::uint64 DroppedTraceEvents()
+{
+  return GetTracer().GetDropped();
+}
+
+void TraceInstant(const char* name)
+{
+  if (IsTracingEnabled())
+  {
+    RecordEvent({name, trace_detail::TraceClock(), 0, INSTANT_PHASE});
+  }
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+namespace
+{
+const bool tracing_enabled_from_environment = EnableTracingFromEnvironment();
+
+ThreadTraceBuffer::ThreadTraceBuffer(sup::dto::uint32 thread_id)
+  : m_events{}
+  , m_head{0}
+  , m_tail{0}
+  , m_dropped{0}
+  , m_finished{false}
+  , m_thread_id{thread_id}
+{}
+
+ThreadTraceBuffer::~ThreadTraceBuffer() = default;
+
+void ThreadTraceBuffer::Push(const TraceEvent& event)
+{
+  auto head = m_head.load(std::memory_order_relaxed);
+  if (head - m_tail.load(std::memory_order_acquire) >= TRACE_BUFFER_CAPACITY)
+  {
+    (void)m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  m_events[head % TRACE_BUFFER_CAPACITY] = event;
+  m_head.store(head + 1, std::memory_order_release);
+}
+
+template <typename F>
+void ThreadTraceBuffer::Drain(F&& func)
+{
+  auto tail = m_tail.load(std::memory_order_relaxed);
+  auto head = m_head.load(std::memory_order_acquire);
+  for (; tail != head; ++tail)
+  {
+    func(m_events[tail % TRACE_BUFFER_CAPACITY]);
+  }
+  m_tail.store(tail, std::memory_order_release);
+}
+
+sup::dto::uint32 ThreadTraceBuffer::GetThreadId() const
+{
+  return m_thread_id;
+}
+
+sup::dto::uint64 ThreadTraceBuffer::GetDropped() const
+{
+  return m_dropped.load(std::memory_order_relaxed);
+}
+
+void ThreadTraceBuffer::SetFinished()
+{
+  m_finished.store(true, std::memory_order_release);
+}
+
+bool ThreadTraceBuffer::IsFinished() const
+{
+  return m_finished.load(std::memory_order_acquire);
+}
+
+Tracer::Tracer()
+  : m_mtx{}
+  , m_buffers{}
+  , m_file{}
+  , m_first_event{true}
+  , m_next_thread_id{1}
+  , m_dropped_finished{0}
+{}
+
+Tracer::~Tracer()
+{
+  sup::oac_tree::epics_helper::trace_detail::tracing_enabled.store(false,
+                                                                   std::memory_order_relaxed);
+  Close();
+}
+
+std::shared_ptr<ThreadTraceBuffer> Tracer::RegisterThread()
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  auto buffer = std::make_shared<ThreadTraceBuffer>(m_next_thread_id++);
+  m_buffers.push_back(buffer);
+  return buffer;
+}
+
+void Tracer::Open(const std::string& filename)
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  if (m_file.is_open())
+  {
+    FlushImpl();
+    m_file << "\n]\n";
+    m_file.close();
+  }
+  m_file.open(filename, std::ios::out | std::ios::trunc);
+  // The closing bracket is optional in the Chrome trace format: the file stays readable when
+  // the process does not exit cleanly
+  m_file << "[\n";
+  m_file << std::fixed << std::setprecision(3);
+  m_first_event = true;
+}
+
+void Tracer::Close()
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  if (!m_file.is_open())
+  {
+    return;
+  }
+  FlushImpl();
+  m_file << "\n]\n";
+  m_file.close();
+}
+
+void Tracer::Flush()
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  FlushImpl();
+}
+
+sup::dto::uint64 Tracer::GetDropped()
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  auto result = m_dropped_finished;
+  for (const auto& buffer : m_buffers)
+  {
+    result += buffer->GetDropped();
+  }
+  return result;
+}
+
+void Tracer::FlushImpl()
+{
+  // Read the finished flag before draining: a finished thread pushes no more events
+  std::vector<bool> finished;
+  finished.reserve(m_buffers.size());
+  for (const auto& buffer : m_buffers)
+  {
+    finished.push_back(buffer->IsFinished());
+    auto thread_id = buffer->GetThreadId();
+    buffer->Drain([this, thread_id](const TraceEvent& event) { WriteEvent(event, thread_id); });
+  }
+  std::size_t idx = 0;
+  for (std::size_t i = 0; i < m_buffers.size(); ++i)
+  {
+    if (finished[i])
+    {
+      m_dropped_finished += m_buffers[i]->GetDropped();
+      continue;
+    }
+    m_buffers[idx++] = std::move(m_buffers[i]);
+  }
+  m_buffers.resize(idx);
+  if (m_file.is_open())
+  {
+    (void)m_file.flush();
+  }
+}
+
+void Tracer::WriteEvent(const TraceEvent& event, sup::dto::uint32 thread_id)
+{
+  if (!m_file.is_open())
+  {
+    return;
+  }
+  if (!m_first_event)
+  {
+    m_file << ",\n";
+  }
+  m_first_event = false;
+  m_file << R"({"name":")" << event.name << R"(","cat":")" << TRACE_CATEGORY
+         << R"(","ph":")" << event.phase << R"(","ts":)" << event.start_ns / 1000.0;
+  if (event.phase == SPAN_PHASE)
+  {
+    m_file << R"(,"dur":)" << event.duration_ns / 1000.0;
+  }
+  else
+  {
+    m_file << R"(,"s":"t")";
+  }
+  m_file << R"(,"pid":)" << ::getpid() << R"(,"tid":)" << thread_id << "}";
+}
+
+ThreadBufferHandle::ThreadBufferHandle()
+  : m_buffer{}
+{}
+
+ThreadBufferHandle::~ThreadBufferHandle()
+{
+  if (m_buffer)
+  {
+    m_buffer->SetFinished();
+  }
+}
+
+ThreadTraceBuffer& ThreadBufferHandle::Get()
+{
+  if (!m_buffer)
+  {
+    m_buffer = GetTracer().RegisterThread();
+  }
+  return *m_buffer;
+}
+
+Tracer& GetTracer()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+void RecordEvent(const TraceEvent& event)
+{
+  thread_local ThreadBufferHandle handle;
+  handle.Get().Push(event);
+}
+
+bool EnableTracingFromEnvironment()
+{
+  using sup::oac_tree::epics_helper::TRACE_FILE_ENVIRONMENT_VARIABLE;
+  const char* filename = std::getenv(TRACE_FILE_ENVIRONMENT_VARIABLE.c_str());
+  if (filename == nullptr || *filename == '\0')
+  {
+    return false;
+  }
+  sup::oac_tree::epics_helper::EnableTracing(filename);
+  return true;
+}
+}  // unnamed namespace
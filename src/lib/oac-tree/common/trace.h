@@ -0,0 +1,130 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Tracing of plugin operations
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_TRACE_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_TRACE_H_
+
+#include <sup/dto/anyvalue.h>
+
+#include <atomic>
+#include <string>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Name of the environment variable that enables tracing: when it is set at load time of
+ * the plugins, trace events are written to the file it designates.
+ */
+extern const std::string TRACE_FILE_ENVIRONMENT_VARIABLE;
+
+namespace trace_detail
+{
+extern std::atomic<bool> tracing_enabled;
+
+sup::dto::uint64 TraceClock();
+
+void RecordSpan(const char* name, sup::dto::uint64 start_ns);
+}  // namespace trace_detail
+
+/**
+ * @brief Check if trace events are currently recorded.
+ */
+inline bool IsTracingEnabled()
+{
+  return trace_detail::tracing_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Start recording trace events, which will be written to the given file in the Chrome
+ * trace event format (supported by chrome://tracing and Perfetto). Events recorded for a previous
+ * file are flushed first.
+ */
+void EnableTracing(const std::string& filename);
+
+/**
+ * @brief Stop recording trace events and write the pending ones to the trace file.
+ */
+void DisableTracing();
+
+/**
+ * @brief Write the pending trace events of all threads to the trace file.
+ *
+ * @details Events are buffered per thread and only written when flushing. Variables flush on
+ * teardown and pending events are flushed when the process exits. Events recorded while the
+ * buffer of a thread is full are dropped and counted.
+ */
+void FlushTrace();
+
+/**
+ * @brief Number of trace events dropped because the buffer of their thread was full.
+ */
+sup::dto::uint64 DroppedTraceEvents();
+
+/**
+ * @brief Record a point in time.
+ *
+ * @param name Static string naming the event.
+ */
+void TraceInstant(const char* name);
+
+/**
+ * @brief Records the lifetime of the object as a span, when tracing is enabled at construction.
+ *
+ * @details Span names must be string literals, as only the pointer is recorded. When tracing is
+ * disabled, the overhead is a relaxed atomic load.
+ */
+class TraceSpan
+{
+public:
+  explicit TraceSpan(const char* name)
+    : m_name{IsTracingEnabled() ? name : nullptr}
+    , m_start{m_name == nullptr ? 0 : trace_detail::TraceClock()}
+  {}
+
+  ~TraceSpan()
+  {
+    if (m_name != nullptr)
+    {
+      trace_detail::RecordSpan(m_name, m_start);
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+  const char* m_name;
+  sup::dto::uint64 m_start;
+};
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_TRACE_H_
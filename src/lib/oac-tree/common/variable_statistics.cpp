@@ -0,0 +1,245 @@
+/******************************************************************************
+* $HeadURL: $
+* $Id: $
+*
+* Project       : CODAC Supervision and Automation (SUP) oac-tree component
+*
+* Description   : Runtime statistics of EPICS variables
+*
+* Author        : Walter Van Herck (IO)
+*
+* Copyright (c) : 2010-2026 ITER Organization,
+*                 CS 90 046
+*                 13067 St. Paul-lez-Durance Cedex
+*                 France
+* SPDX-License-Identifier: MIT
+*
+* This file is part of ITER CODAC software.
+* For the terms and conditions of redistribution or use of this software
+* refer to the file LICENSE located in the top level directory
+* of the distribution package.
+******************************************************************************/
+
+#include "variable_statistics.h"
+
+#include "live_object_registry.h"
+#include "numeric_traits.h"
+
+#include <chrono>
+#include <cstdlib>
+
+namespace
+{
+// Gain of the jitter estimator, as in RFC 3550
+const sup::dto::int64 JITTER_GAIN_DIVISOR = 16;
+
+const std::string STATISTICS_ENVIRONMENT_VARIABLE = "OAC_TREE_EPICS_STATISTICS";
+
+using VariableStatisticsRegistry =
+  sup::oac_tree::epics_helper::LiveObjectRegistry<sup::oac_tree::epics_helper::VariableStatistics>;
+
+VariableStatisticsRegistry& GetVariableStatisticsRegistry();
+
+std::atomic<bool>& StatisticsEnabled();
+
+bool StatisticsEnabledFromEnvironment();
+
+sup::dto::int64 SteadyClockNanoseconds();
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+VariableStatistics::VariableStatistics(const std::string& variable_type,
+                                       const std::string& channel, bool counting)
+  : m_updates_received{0}
+  , m_conversion_failures{0}
+  , m_notify_count{0}
+  , m_bytes_received{0}
+  , m_last_update_ns{0}
+  , m_last_interval_ns{0}
+  , m_jitter_ns{0}
+  , m_connected{false}
+  , m_counting{counting}
+  , m_variable_type{variable_type}
+  , m_channel{channel}
+{}
+
+VariableStatistics::~VariableStatistics() = default;
+
+const std::string& VariableStatistics::GetVariableType() const
+{
+  return m_variable_type;
+}
+
+const std::string& VariableStatistics::GetChannel() const
+{
+  return m_channel;
+}
+
+void VariableStatistics::RecordUpdate(std::size_t n_bytes)
+{
+  if (!m_counting)
+  {
+    return;
+  }
+  auto now = SteadyClockNanoseconds();
+  (void)m_updates_received.fetch_add(1, std::memory_order_relaxed);
+  (void)m_bytes_received.fetch_add(n_bytes, std::memory_order_relaxed);
+  // Only advance the time of the last update: a concurrent writer may have recorded a later one
+  auto last_update = m_last_update_ns.load(std::memory_order_relaxed);
+  while (now > last_update &&
+         !m_last_update_ns.compare_exchange_weak(last_update, now, std::memory_order_relaxed))
+  {}
+  if (last_update == 0 || now <= last_update)
+  {
+    return;
+  }
+  auto interval = now - last_update;
+  auto last_interval = m_last_interval_ns.exchange(interval, std::memory_order_relaxed);
+  if (last_interval == 0)
+  {
+    return;
+  }
+  auto jitter = m_jitter_ns.load(std::memory_order_relaxed);
+  sup::dto::int64 new_jitter = 0;
+  do
+  {
+    new_jitter = jitter + (std::llabs(interval - last_interval) - jitter) / JITTER_GAIN_DIVISOR;
+  } while (!m_jitter_ns.compare_exchange_weak(jitter, new_jitter, std::memory_order_relaxed));
+}
+
+void VariableStatistics::RecordConversionFailure()
+{
+  if (!m_counting)
+  {
+    return;
+  }
+  (void)m_conversion_failures.fetch_add(1, std::memory_order_relaxed);
+}
+
+void VariableStatistics::RecordNotify()
+{
+  if (!m_counting)
+  {
+    return;
+  }
+  (void)m_notify_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void VariableStatistics::SetConnected(bool connected)
+{
+  m_connected.store(connected, std::memory_order_relaxed);
+}
+
+VariableStatisticsSnapshot VariableStatistics::GetSnapshot() const
+{
+  VariableStatisticsSnapshot result{};
+  result.connected = m_connected.load(std::memory_order_relaxed);
+  result.updates_received = m_updates_received.load(std::memory_order_relaxed);
+  result.conversion_failures = m_conversion_failures.load(std::memory_order_relaxed);
+  result.notify_count = m_notify_count.load(std::memory_order_relaxed);
+  result.bytes_received = m_bytes_received.load(std::memory_order_relaxed);
+  auto last_update = m_last_update_ns.load(std::memory_order_relaxed);
+  result.last_update_age =
+    last_update == 0 ? -1.0 : 1e-9 * static_cast<double>(SteadyClockNanoseconds() - last_update);
+  result.jitter = 1e-9 * static_cast<double>(m_jitter_ns.load(std::memory_order_relaxed));
+  return result;
+}
+
+void SetVariableStatisticsEnabled(bool enabled)
+{
+  StatisticsEnabled().store(enabled, std::memory_order_relaxed);
+}
+
+bool VariableStatisticsEnabled()
+{
+  return StatisticsEnabled().load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<VariableStatistics> CreateVariableStatistics(const std::string& variable_type,
+                                                             const std::string& channel)
+{
+  auto statistics =
+    std::make_shared<VariableStatistics>(variable_type, channel, VariableStatisticsEnabled());
+  GetVariableStatisticsRegistry().Add(statistics);
+  return statistics;
+}
+
+std::vector<std::shared_ptr<const VariableStatistics>> GetVariableStatistics()
+{
+  return GetVariableStatisticsRegistry().GetAll();
+}
+
+std::size_t FixedPayloadSize(const sup::dto::AnyType& anytype)
+{
+  if (sup::dto::IsStructType(anytype))
+  {
+    std::size_t result = 0;
+    for (const auto& member_name : anytype.MemberNames())
+    {
+      auto member_size = FixedPayloadSize(anytype[member_name]);
+      if (member_size == 0)
+      {
+        return 0;
+      }
+      result += member_size;
+    }
+    return result;
+  }
+  if (sup::dto::IsArrayType(anytype))
+  {
+    return anytype.NumberOfElements() * FixedPayloadSize(anytype.ElementType());
+  }
+  auto type_code = anytype.GetTypeCode();
+  if (type_code == sup::dto::TypeCode::Bool || type_code == sup::dto::TypeCode::Char8)
+  {
+    return 1;
+  }
+  auto native_size = [](auto tag) {
+    return sizeof(typename decltype(tag)::type);
+  };
+  return DispatchNumericType(type_code, native_size, std::size_t{0});
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+namespace
+{
+VariableStatisticsRegistry& GetVariableStatisticsRegistry()
+{
+  static VariableStatisticsRegistry registry;
+  return registry;
+}
+
+std::atomic<bool>& StatisticsEnabled()
+{
+  static std::atomic<bool> enabled{StatisticsEnabledFromEnvironment()};
+  return enabled;
+}
+
+bool StatisticsEnabledFromEnvironment()
+{
+  const char* enabled_str = std::getenv(STATISTICS_ENVIRONMENT_VARIABLE.c_str());
+  if (enabled_str == nullptr)
+  {
+    return true;
+  }
+  const std::string value{enabled_str};
+  return value != "0" && value != "false" && value != "off";
+}
+
+sup::dto::int64 SteadyClockNanoseconds()
+{
+  auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+}
+}  // unnamed namespace
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Runtime statistics of EPICS variables
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_VARIABLE_STATISTICS_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_VARIABLE_STATISTICS_H_
+
+#include <sup/dto/anyvalue.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Assumed size of a cache line, used to keep the counters of different variables apart.
+ */
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Copy of the runtime statistics of a variable at a given time.
+ */
+struct VariableStatisticsSnapshot
+{
+  bool connected;
+  sup::dto::uint64 updates_received;
+  sup::dto::uint64 conversion_failures;
+  sup::dto::uint64 notify_count;
+  sup::dto::uint64 bytes_received;  // Zero when the payload size is not known
+  double last_update_age;           // Seconds, negative when no update was received yet
+  double jitter;                    // Seconds, smoothed variation of the inter-arrival time
+};
+
+/**
+ * @brief Runtime statistics of an EPICS-backed workspace variable.
+ *
+ * @details The counters are relaxed atomics within a single cache line, so recording costs a few
+ * uncontended atomic operations and reading them never blocks the update path. The inter-arrival
+ * jitter is estimated as in RFC 3550: J += (|D| - J) / 16, with D the difference between two
+ * consecutive inter-arrival times.
+ *
+ * @note All methods can be called from several threads, e.g. from the monitor or server callback
+ * and from readers of the variable. When updates are recorded concurrently, an update that is
+ * older than the last recorded one only counts and does not contribute to the jitter.
+ * @note Statistics created while counting is disabled (see SetVariableStatisticsEnabled) ignore
+ * the Record methods and only keep the connection state.
+ */
+class alignas(CACHE_LINE_SIZE) VariableStatistics
+{
+public:
+  VariableStatistics(const std::string& variable_type, const std::string& channel,
+                     bool counting = true);
+  ~VariableStatistics();
+
+  const std::string& GetVariableType() const;
+  const std::string& GetChannel() const;
+
+  /**
+   * @brief Record the reception of an update with the given payload size in bytes.
+   */
+  void RecordUpdate(std::size_t n_bytes);
+
+  void RecordConversionFailure();
+
+  void RecordNotify();
+
+  /**
+   * @brief Record the connection state of the channel. Server variables are always connected.
+   */
+  void SetConnected(bool connected);
+
+  VariableStatisticsSnapshot GetSnapshot() const;
+
+private:
+  std::atomic<sup::dto::uint64> m_updates_received;
+  std::atomic<sup::dto::uint64> m_conversion_failures;
+  std::atomic<sup::dto::uint64> m_notify_count;
+  std::atomic<sup::dto::uint64> m_bytes_received;
+  std::atomic<sup::dto::int64> m_last_update_ns;
+  std::atomic<sup::dto::int64> m_last_interval_ns;
+  std::atomic<sup::dto::int64> m_jitter_ns;
+  std::atomic<bool> m_connected;
+  const bool m_counting;
+  const std::string m_variable_type;
+  const std::string m_channel;
+};
+
+/**
+ * @brief Enable or disable the counters of statistics that are created afterwards.
+ *
+ * @details Counting is enabled by default, unless the environment variable
+ * OAC_TREE_EPICS_STATISTICS is set to "0", "false" or "off".
+ */
+void SetVariableStatisticsEnabled(bool enabled);
+
+bool VariableStatisticsEnabled();
+
+/**
+ * @brief Create the statistics for a variable and make them available through
+ * GetVariableStatistics for as long as the returned pointer is kept alive.
+ */
+std::shared_ptr<VariableStatistics> CreateVariableStatistics(const std::string& variable_type,
+                                                             const std::string& channel);
+
+/**
+ * @brief Retrieve the statistics of all variables that are currently set up.
+ */
+std::vector<std::shared_ptr<const VariableStatistics>> GetVariableStatistics();
+
+/**
+ * @brief Size in bytes of the data of a value with the given type.
+ *
+ * @return Size or zero when it is not fixed by the type, e.g. when the type contains strings.
+ */
+std::size_t FixedPayloadSize(const sup::dto::AnyType& anytype);
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_VARIABLE_STATISTICS_H_
@@ -0,0 +1,84 @@
+/******************************************************************************
+* $HeadURL: $
+* $Id: $
+*
+* Project       : CODAC Supervision and Automation (SUP) oac-tree component
+*
+* Description   : Signal to wake up instructions waiting for a channel
+*
+* Author        : Walter Van Herck (IO)
+*
+* Copyright (c) : 2010-2026 ITER Organization,
+*                 CS 90 046
+*                 13067 St. Paul-lez-Durance Cedex
+*                 France
+* SPDX-License-Identifier: MIT
+*
+* This file is part of ITER CODAC software.
+* For the terms and conditions of redistribution or use of this software
+* refer to the file LICENSE located in the top level directory
+* of the distribution package.
+******************************************************************************/
+#include "wakeup_signal.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+sup::dto::uint64 NanosecondsSinceEpoch();
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+WakeupSignal::WakeupSignal()
+  : m_mtx{}
+  , m_cv{}
+  , m_count{0}
+{}
+
+WakeupSignal::~WakeupSignal() = default;
+
+sup::dto::uint64 WakeupSignal::GetCount() const
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  return m_count;
+}
+
+void WakeupSignal::Signal()
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    ++m_count;
+  }
+  m_cv.notify_all();
+}
+
+bool WakeupSignal::WaitForSignal(sup::dto::uint64 count, sup::dto::uint64 deadline_ns)
+{
+  auto now = NanosecondsSinceEpoch();
+  auto timeout_ns = deadline_ns > now ? std::min(deadline_ns - now, MAX_WAKEUP_WAIT_NS) : 0;
+  std::unique_lock<std::mutex> lk{m_mtx};
+  return m_cv.wait_for(lk, std::chrono::nanoseconds(timeout_ns),
+                       [this, count]() { return m_count != count; });
+}
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+namespace
+{
+sup::dto::uint64 NanosecondsSinceEpoch()
+{
+  auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+}
+}  // unnamed namespace
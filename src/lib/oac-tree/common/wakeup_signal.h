@@ -0,0 +1,100 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - oac-tree
+ *
+ * Description   : Signal to wake up instructions waiting for a channel
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_WAKEUP_SIGNAL_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_WAKEUP_SIGNAL_H_
+
+#include <sup/dto/anyvalue.h>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace sup
+{
+namespace oac_tree
+{
+namespace epics_helper
+{
+
+/**
+ * @brief Maximum time an instruction blocks in a single call to ExecuteSingle while waiting for
+ * a connection or reply. Bounding the wait keeps halt requests and the tick of the procedure
+ * responsive, while removing the busy polling of a channel that is not yet connected.
+ */
+const sup::dto::uint64 MAX_WAKEUP_WAIT_NS = 50000000;  // 50 ms
+
+/**
+ * @brief Signal raised from EPICS callbacks to wake up an instruction that waits for a channel
+ * to connect or for a value to arrive.
+ *
+ * @details Signals are counted, so a signal raised between reading the count and waiting for it
+ * is not lost:
+ * @code
+     auto count = signal.GetCount();
+     if (!IsReady())
+     {
+       (void)signal.WaitForSignal(count, deadline_ns);
+     }
+   @endcode
+ */
+class WakeupSignal
+{
+public:
+  WakeupSignal();
+  ~WakeupSignal();
+
+  WakeupSignal(const WakeupSignal&) = delete;
+  WakeupSignal& operator=(const WakeupSignal&) = delete;
+
+  /**
+   * @brief Number of signals raised until now.
+   */
+  sup::dto::uint64 GetCount() const;
+
+  /**
+   * @brief Raise the signal, waking up all waiting threads.
+   */
+  void Signal();
+
+  /**
+   * @brief Wait until a signal is raised after the given count was read, or until the deadline.
+   *
+   * @param count Count that was read before checking the condition to wait for.
+   * @param deadline_ns Deadline in nanoseconds since the epoch (see utils::GetNanosecsSinceEpoch).
+   * The wait is additionally bounded by MAX_WAKEUP_WAIT_NS.
+   * @return true when signalled.
+   */
+  bool WaitForSignal(sup::dto::uint64 count, sup::dto::uint64 deadline_ns);
+
+private:
+  mutable std::mutex m_mtx;
+  std::condition_variable m_cv;
+  sup::dto::uint64 m_count;
+};
+
+}  // namespace epics_helper
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_WAKEUP_SIGNAL_H_
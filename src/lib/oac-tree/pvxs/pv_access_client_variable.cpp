@@ -24,7 +24,13 @@
 
 #include "pv_access_helper.h"
 
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/plugin_diagnostics.h>
+#include <oac-tree/common/trace.h>
+
+#include <sup/oac-tree/constants.h>
 #include <sup/oac-tree/exceptions.h>
+#include <sup/oac-tree/generic_utils.h>
 #include <sup/oac-tree/variable_registry.h>
 #include <sup/oac-tree/workspace.h>
 
@@ -45,60 +51,129 @@ const std::string TYPE_ATTRIBUTE_NAME = "type";
 
 PvAccessClientVariable::PvAccessClientVariable()
   : Variable(PvAccessClientVariable::Type)
+  , m_mode{epics_helper::ClientMode::kMonitor}
+  , m_last_connected{false}
   , m_anytype{}
+  , m_wire_value{}
+  , m_wire_mutex{}
+  , m_scalar_conversion{}
+  , m_payload_size{0}
+  , m_statistics{}
+  , m_latency_file{}
+  , m_latency{}
+  , m_connection{}
+  , m_monitored{}
+  , m_get_wakeup{}
+  , m_get_timeout{pv_access_helper::DEFAULT_TIMEOUT_NS}
+  , m_max_age{0}
+  , m_get_mutex{}
+  , m_get_value{}
+  , m_get_time{0}
   , m_pv{}
 {
   (void)AddAttributeDefinition(CHANNEL_ATTRIBUTE_NAME, sup::dto::StringType).SetMandatory();
   (void)AddAttributeDefinition(TYPE_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(epics_helper::LATENCY_FILE_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(epics_helper::CONNECT_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(epics_helper::CONNECT_PRIORITY_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(epics_helper::MODE_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(epics_helper::MAX_AGE_ATTRIBUTE_NAME, sup::dto::StringType);
+  (void)AddAttributeDefinition(Constants::TIMEOUT_SEC_ATTRIBUTE_NAME, sup::dto::StringType);
 }
 
 PvAccessClientVariable::~PvAccessClientVariable() = default;
 
 bool PvAccessClientVariable::GetValueImpl(sup::dto::AnyValue& value) const
 {
-  if (!m_pv || !m_pv->IsConnected())
+  if (m_mode == epics_helper::ClientMode::kConnection)
+  {
+    auto pv = m_pv.Get();
+    sup::dto::AnyValue connected{pv != nullptr && pv->IsConnected()};
+    return epics_helper::MoveOrAssign(value, std::move(connected));
+  }
+  if (m_mode == epics_helper::ClientMode::kGet)
+  {
+    auto fetched_val = GetFromChannel();
+    return !sup::dto::IsEmptyValue(fetched_val) &&
+           epics_helper::MoveOrAssign(value, std::move(fetched_val));
+  }
+  auto pv = m_pv.GetConnected(epics_helper::FIRST_ACCESS_TIMEOUT_SEC);
+  if (pv == nullptr || !pv->IsConnected())
   {
     return false;
   }
-  auto converted_val = pv_access_helper::ConvertToTypedAnyValue(m_pv->GetValue(), m_anytype);
-  return !sup::dto::IsEmptyValue(converted_val) && sup::dto::TryAssign(value, converted_val);
+  auto converted_val = pv_access_helper::ConvertToTypedAnyValue(pv->GetValue(), m_anytype);
+  return !sup::dto::IsEmptyValue(converted_val) &&
+         epics_helper::MoveOrAssign(value, std::move(converted_val));
 }
 
 bool PvAccessClientVariable::SetValueImpl(const sup::dto::AnyValue& value)
 {
-  if (!m_pv || !m_pv->IsConnected())
+  if (m_mode != epics_helper::ClientMode::kMonitor)
+  {
+    return false;
+  }
+  auto pv = m_pv.GetConnected(epics_helper::FIRST_ACCESS_TIMEOUT_SEC);
+  if (pv == nullptr || !pv->IsConnected())
   {
     return false;
   }
-  sup::dto::AnyValue copy;
   if (sup::dto::IsEmptyType(m_anytype))
   {
-    copy = value;
+    return sup::dto::IsScalarValue(value)
+             ? pv->SetValue(pv_access_helper::PackIntoStructIfScalar(value))
+             : pv->SetValue(value);
   }
-  else
+  if (!sup::dto::IsScalarType(m_anytype) && value.GetType() == m_anytype)
   {
-    copy = sup::dto::AnyValue(m_anytype);
-    if (!sup::dto::TryConvert(copy, value))
-    {
-      return false;
-    }
+    // No conversion or wrapping structure needed: pass the value without copying it
+    return pv->SetValue(value);
   }
-  return m_pv->SetValue(pv_access_helper::PackIntoStructIfScalar(copy));
+  std::lock_guard<std::mutex> lk{m_wire_mutex};
+  return pv_access_helper::ConvertIntoWireValue(m_wire_value, m_anytype, value) &&
+         pv->SetValue(m_wire_value);
 }
 
 bool PvAccessClientVariable::IsAvailableImpl() const
 {
-  if (!m_pv || !m_pv->IsConnected())
+  if (m_mode == epics_helper::ClientMode::kConnection)
+  {
+    // The connection state is always known, but the first access still creates a lazy channel
+    (void)m_pv.Get();
+    return true;
+  }
+  auto pv = m_pv.GetConnected(epics_helper::FIRST_ACCESS_TIMEOUT_SEC);
+  if (pv == nullptr || !pv->IsConnected())
   {
     return false;
   }
-  auto value = pv_access_helper::ConvertToTypedAnyValue(m_pv->GetValue(), m_anytype);
+  if (m_mode == epics_helper::ClientMode::kGet)
+  {
+    // Values are only converted when read
+    return true;
+  }
+  auto value = pv_access_helper::ConvertToTypedAnyValue(pv->GetValue(), m_anytype);
   return !sup::dto::IsEmptyValue(value);
 }
 
 SetupTeardownActions PvAccessClientVariable::SetupImpl(const Workspace& ws)
 {
-  if (HasAttribute(TYPE_ATTRIBUTE_NAME))
+  if (HasAttribute(epics_helper::MODE_ATTRIBUTE_NAME))
+  {
+    auto mode_attr = GetAttributeString(epics_helper::MODE_ATTRIBUTE_NAME);
+    if (!epics_helper::ParseClientMode(mode_attr, m_mode))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + epics_helper::MODE_ATTRIBUTE_NAME + "] with value [" +
+        mode_attr + "]";
+      throw VariableSetupException(error_message);
+    }
+  }
+  if (m_mode == epics_helper::ClientMode::kConnection)
+  {
+    m_anytype = sup::dto::BooleanType;
+  }
+  else if (HasAttribute(TYPE_ATTRIBUTE_NAME))
   {
     auto type_attr = GetAttributeString(TYPE_ATTRIBUTE_NAME);
     if (type_attr.empty())
@@ -116,23 +191,241 @@ SetupTeardownActions PvAccessClientVariable::SetupImpl(const Workspace& ws)
       throw VariableSetupException(error_message);
     }
     m_anytype = parser.MoveAnyType();
+    m_wire_value = pv_access_helper::CreateWireValue(m_anytype);
+  }
+  bool lazy = false;
+  if (HasAttribute(epics_helper::CONNECT_ATTRIBUTE_NAME))
+  {
+    auto connect_attr = GetAttributeString(epics_helper::CONNECT_ATTRIBUTE_NAME);
+    if (!epics_helper::ParseConnectMode(connect_attr, lazy))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + epics_helper::CONNECT_ATTRIBUTE_NAME + "] with value [" +
+        connect_attr + "]";
+      throw VariableSetupException(error_message);
+    }
+  }
+  if (HasAttribute(epics_helper::MAX_AGE_ATTRIBUTE_NAME))
+  {
+    auto max_age_attr = GetAttributeString(epics_helper::MAX_AGE_ATTRIBUTE_NAME);
+    if (!epics_helper::ParseSeconds(max_age_attr, m_max_age))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + epics_helper::MAX_AGE_ATTRIBUTE_NAME + "] with value [" +
+        max_age_attr + "]";
+      throw VariableSetupException(error_message);
+    }
+  }
+  if (HasAttribute(Constants::TIMEOUT_SEC_ATTRIBUTE_NAME))
+  {
+    auto timeout_attr = GetAttributeString(Constants::TIMEOUT_SEC_ATTRIBUTE_NAME);
+    if (!epics_helper::ParseSeconds(timeout_attr, m_get_timeout))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + Constants::TIMEOUT_SEC_ATTRIBUTE_NAME + "] with value [" +
+        timeout_attr + "]";
+      throw VariableSetupException(error_message);
+    }
+  }
+  sup::dto::int32 priority = 0;
+  if (HasAttribute(epics_helper::CONNECT_PRIORITY_ATTRIBUTE_NAME))
+  {
+    auto priority_attr = GetAttributeString(epics_helper::CONNECT_PRIORITY_ATTRIBUTE_NAME);
+    if (!epics_helper::ParseConnectPriority(priority_attr, priority))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + epics_helper::CONNECT_PRIORITY_ATTRIBUTE_NAME +
+        "] with value [" + priority_attr + "]";
+      throw VariableSetupException(error_message);
+    }
+  }
+  m_scalar_conversion = epics_helper::ScalarConversion{m_anytype};
+  m_payload_size = epics_helper::FixedPayloadSize(m_anytype);
+  auto channel = GetAttributeString(CHANNEL_ATTRIBUTE_NAME);
+  m_statistics = epics_helper::CreateVariableStatistics(PvAccessClientVariable::Type, channel);
+  if (HasAttribute(epics_helper::LATENCY_FILE_ATTRIBUTE_NAME))
+  {
+    m_latency_file = GetAttributeString(epics_helper::LATENCY_FILE_ATTRIBUTE_NAME);
+    m_latency = epics_helper::CreateChannelLatency(PvAccessClientVariable::Type, channel);
+  }
+  m_connection = std::make_shared<epics_helper::ScheduledConnection>(priority);
+  if (m_mode == epics_helper::ClientMode::kMonitor)
+  {
+    m_monitored = std::make_shared<epics_helper::MonitoredChannel<sup::dto::AnyValue>>([this]() {
+      auto pv = m_pv.Get();
+      return pv != nullptr ? pv->GetValue() : sup::dto::AnyValue{};
+    });
+    pv_access_helper::GetMonitorRegistry().Register(channel, sup::dto::EmptyType, m_monitored);
+  }
+  if (m_mode == epics_helper::ClientMode::kGet)
+  {
+    m_get_wakeup = std::make_shared<epics_helper::WakeupSignal>();
   }
   // Avoid dependence on destruction order of m_pv and m_anytype.
-  auto callback = [this](const epics::PvAccessClientPV::ExtendedValue& ext_value)
+  auto callback = [this, statistics = m_statistics, latency = m_latency,
+                   connection = m_connection, monitored = m_monitored, get_wakeup = m_get_wakeup](
+                    const epics::PvAccessClientPV::ExtendedValue& ext_value)
   {
-    auto value = pv_access_helper::ConvertToTypedAnyValue(ext_value.value, m_anytype);
-    Notify(value, ext_value.connected);
+    epics_helper::ActiveCallbackGuard callback_guard;
+    epics_helper::TraceSpan callback_span{"PvAccessClient.monitor"};
+    if (m_mode == epics_helper::ClientMode::kConnection)
+    {
+      HandleConnectionUpdate(ext_value.connected);
+      return;
+    }
+    if (m_mode == epics_helper::ClientMode::kGet)
+    {
+      // Conversion is left to the reads: only wake up a read waiting for the first value
+      statistics->SetConnected(ext_value.connected);
+      if (ext_value.connected)
+      {
+        connection->MarkConnected();
+      }
+      get_wakeup->Signal();
+      return;
+    }
+    auto receipt_time = latency ? epics_helper::LatencyClock() : 0;
+    monitored->SetLastUpdate(ext_value.connected ? utils::GetNanosecsSinceEpoch() : 0);
+    statistics->SetConnected(ext_value.connected);
+    if (ext_value.connected)
+    {
+      connection->MarkConnected();
+      statistics->RecordUpdate(m_payload_size);
+    }
+    sup::dto::AnyValue value;
+    {
+      epics_helper::TraceSpan conversion_span{"PvAccessClient.convert"};
+      value =
+        pv_access_helper::ConvertToTypedAnyValue(ext_value.value, m_anytype, m_scalar_conversion);
+    }
+    if (ext_value.connected && sup::dto::IsEmptyValue(value))
+    {
+      statistics->RecordConversionFailure();
+    }
+    statistics->RecordNotify();
+    {
+      epics_helper::TraceSpan notify_span{"PvAccessClient.notify"};
+      Notify(value, ext_value.connected);
+    }
+    if (latency && ext_value.connected)
+    {
+      latency->RecordUpdate(pv_access_helper::GetTimestamp(ext_value.value), receipt_time,
+                            epics_helper::LatencyClock());
+    }
     return;
   };
-  m_pv = std::make_unique<epics::PvAccessClientPV>(
-    GetAttributeString(CHANNEL_ATTRIBUTE_NAME), callback);
+  m_pv.Create(
+    [channel, callback]() { return std::make_unique<epics::PvAccessClientPV>(channel, callback); },
+    true);
+  if (!lazy)
+  {
+    epics_helper::GetConnectionScheduler().Schedule(m_connection, [this]() { (void)m_pv.Get(); });
+  }
+  if (m_mode == epics_helper::ClientMode::kConnection)
+  {
+    Notify(sup::dto::AnyValue{false}, true);
+  }
   return {};
 }
 
 void PvAccessClientVariable::TeardownImpl()
 {
-  m_pv.reset();
+  if (m_monitored)
+  {
+    m_monitored->Close();
+  }
+  if (m_connection)
+  {
+    epics_helper::GetConnectionScheduler().Cancel(*m_connection);
+  }
+  m_pv.Reset();
+  m_connection.reset();
+  m_monitored.reset();
+  epics_helper::FlushTrace();
+  if (m_latency)
+  {
+    (void)epics_helper::AppendChannelLatency(*m_latency, m_latency_file);
+  }
+  m_latency.reset();
+  m_latency_file.clear();
   m_anytype = sup::dto::EmptyType;
+  m_wire_value = sup::dto::AnyValue{};
+  m_scalar_conversion = epics_helper::ScalarConversion{};
+  m_payload_size = 0;
+  m_statistics.reset();
+  m_mode = epics_helper::ClientMode::kMonitor;
+  m_last_connected = false;
+  m_get_wakeup.reset();
+  m_get_timeout = pv_access_helper::DEFAULT_TIMEOUT_NS;
+  m_max_age = 0;
+  m_get_value = sup::dto::AnyValue{};
+  m_get_time = 0;
+}
+
+void PvAccessClientVariable::HandleConnectionUpdate(bool connected)
+{
+  // Values are ignored: only changes of the connection state are notified
+  if (connected == m_last_connected)
+  {
+    return;
+  }
+  m_last_connected = connected;
+  m_statistics->SetConnected(connected);
+  if (connected)
+  {
+    m_connection->MarkConnected();
+  }
+  m_statistics->RecordNotify();
+  Notify(sup::dto::AnyValue{connected}, true);
+}
+
+sup::dto::AnyValue PvAccessClientVariable::GetFromChannel() const
+{
+  epics_helper::TraceSpan get_span{"PvAccessClient.get"};
+  auto start = utils::GetNanosecsSinceEpoch();
+  if (m_max_age > 0)
+  {
+    // The lock only protects the cached value: it is not held while fetching
+    std::lock_guard<std::mutex> lk{m_get_mutex};
+    if (!sup::dto::IsEmptyValue(m_get_value) && start - m_get_time <= m_max_age)
+    {
+      return m_get_value;
+    }
+  }
+  auto pv = m_pv.Get();
+  if (pv == nullptr)
+  {
+    return {};
+  }
+  // Only the first read after connecting needs to wait for a value
+  auto finish = start + m_get_timeout;
+  auto wakeup_count = m_get_wakeup->GetCount();
+  auto ext_value = pv->GetExtendedValue();
+  while (!ext_value.connected || sup::dto::IsEmptyValue(ext_value.value))
+  {
+    if (utils::GetNanosecsSinceEpoch() >= finish)
+    {
+      return {};
+    }
+    (void)m_get_wakeup->WaitForSignal(wakeup_count, finish);
+    wakeup_count = m_get_wakeup->GetCount();
+    ext_value = pv->GetExtendedValue();
+  }
+  m_statistics->RecordUpdate(m_payload_size);
+  // Reads can be concurrent: the scalar conversion of the monitor callback is not shared
+  auto value = pv_access_helper::ConvertToTypedAnyValue(ext_value.value, m_anytype);
+  if (sup::dto::IsEmptyValue(value))
+  {
+    m_statistics->RecordConversionFailure();
+    return {};
+  }
+  if (m_max_age > 0)
+  {
+    std::lock_guard<std::mutex> lk{m_get_mutex};
+    m_get_value = value;
+    m_get_time = utils::GetNanosecsSinceEpoch();
+  }
+  return value;
 }
 
 }  // namespace oac_tree
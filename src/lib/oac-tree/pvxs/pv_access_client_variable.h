@@ -23,9 +23,19 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_CLIENT_VARIABLE_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_CLIENT_VARIABLE_H_
 
+#include <oac-tree/common/connection_scheduler.h>
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/latency_histogram.h>
+#include <oac-tree/common/lazy_channel.h>
+#include <oac-tree/common/monitor_registry.h>
+#include <oac-tree/common/scalar_conversion.h>
+#include <oac-tree/common/variable_statistics.h>
+#include <oac-tree/common/wakeup_signal.h>
+
 #include <sup/oac-tree/variable.h>
 
 #include <memory>
+#include <mutex>
 
 namespace sup
 {
@@ -39,6 +49,25 @@ namespace oac_tree
 /**
  * @brief Workspace variable associated with remote pvAccess server.
  * The variable is configured with mandatory 'channel' (PV name) and optional 'type' attributes.
+ * The optional 'latencyFile' attribute enables latency histograms of the updates (see
+ * epics_helper::ChannelLatency), which are appended to the given file on teardown. The source
+ * latency is only measured for values with a normative type 'timeStamp' field.
+ * With the optional attribute connect="lazy", the channel is only created on the first access to
+ * the variable (get, set or availability check) instead of during setup. That access waits at most
+ * epics_helper::FIRST_ACCESS_TIMEOUT_SEC for the channel to connect.
+ * Otherwise, the channel is created through the plugin's connection scheduler (see
+ * epics_helper::ConnectionScheduler), where the optional 'connectPriority' attribute (default 0)
+ * orders the variables that wait for their turn.
+ * With mode="connection", the variable only exposes the connection state of the channel as a
+ * boolean value, which is notified when it changes. Its value cannot be set.
+ * With mode="get", the variable keeps its channel, but only converts the value of the channel when
+ * it is read, waiting at most 'timeout' seconds (default 2) for a first value. The optional
+ * 'maxAge' attribute (seconds) allows to return a value read at most that long ago instead. The
+ * variable is then read-only and does not notify the workspace of value changes. It is available
+ * while its channel is connected.
+ * In the default mode, the monitor of the variable is published in the plugin's monitor registry
+ * (see pv_access_helper::GetMonitorRegistry), where PvAccessRead instructions with a 'maxAge'
+ * attribute find it.
  * @code
      <Workspace>
        <PvAccessClient name="pvxs-variable"
@@ -62,8 +91,28 @@ private:
   SetupTeardownActions SetupImpl(const Workspace& ws) override;
   void TeardownImpl() override;
 
+  void HandleConnectionUpdate(bool connected);
+  sup::dto::AnyValue GetFromChannel() const;
+
+  epics_helper::ClientMode m_mode;
+  bool m_last_connected;
   sup::dto::AnyType m_anytype;
-  std::unique_ptr<epics::PvAccessClientPV> m_pv;
+  sup::dto::AnyValue m_wire_value;
+  std::mutex m_wire_mutex;
+  epics_helper::ScalarConversion m_scalar_conversion;
+  std::size_t m_payload_size;
+  std::shared_ptr<epics_helper::VariableStatistics> m_statistics;
+  std::string m_latency_file;
+  std::shared_ptr<epics_helper::ChannelLatency> m_latency;
+  std::shared_ptr<epics_helper::ScheduledConnection> m_connection;
+  std::shared_ptr<epics_helper::MonitoredChannel<sup::dto::AnyValue>> m_monitored;
+  std::shared_ptr<epics_helper::WakeupSignal> m_get_wakeup;
+  sup::dto::uint64 m_get_timeout;
+  sup::dto::uint64 m_max_age;
+  mutable std::mutex m_get_mutex;
+  mutable sup::dto::AnyValue m_get_value;
+  mutable sup::dto::uint64 m_get_time;
+  mutable epics_helper::LazyChannel<epics::PvAccessClientPV> m_pv;
 };
 
 }  // namespace oac_tree
@@ -0,0 +1,248 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : CODAC Supervision and Automation (SUP) oac-tree component
+ *
+ * Description   : Variable plugin implementation
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "pv_access_diagnostics_variable.h"
+
+#include "pv_access_server_variable.h"
+#include "pv_access_helper.h"
+#include "pv_access_shared_server_registry.h"
+
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/plugin_diagnostics.h>
+
+#include <sup/oac-tree/exceptions.h>
+#include <sup/oac-tree/variable_registry.h>
+#include <sup/oac-tree/workspace.h>
+
+#include <sup/dto/anyvalue_helper.h>
+
+#include <cstdlib>
+
+namespace
+{
+const double DEFAULT_PERIOD_SEC = 1.0;
+
+bool ParsePeriod(const std::string& period_str, double& period_sec);
+
+/**
+ * @brief Produces the published diagnostics. It keeps the previous update count to compute the
+ * aggregated update rate.
+ */
+class DiagnosticsProducer
+{
+public:
+  DiagnosticsProducer();
+  ~DiagnosticsProducer();
+
+  sup::dto::AnyValue operator()();
+
+private:
+  sup::dto::uint64 m_last_updates;
+  std::chrono::steady_clock::time_point m_last_time;
+};
+
+sup::dto::AnyValue CreateDiagnosticsValue(
+  const sup::oac_tree::epics_helper::PluginDiagnostics& diagnostics, double update_rate);
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree
+{
+const std::string PvAccessDiagnosticsVariable::Type = "PvAccessDiagnostics";
+static const bool PvAccessDiagnosticsVariable_initialised_flag =
+  RegisterGlobalVariable<PvAccessDiagnosticsVariable>();
+
+const std::string CHANNEL_ATTRIBUTE_NAME = "channel";
+const std::string PERIOD_ATTRIBUTE_NAME = "period";
+
+PvAccessDiagnosticsVariable::PvAccessDiagnosticsVariable()
+  : Variable(PvAccessDiagnosticsVariable::Type)
+  , m_channel{}
+  , m_workspace{nullptr}
+{
+  (void)AddAttributeDefinition(CHANNEL_ATTRIBUTE_NAME, sup::dto::StringType).SetMandatory();
+  (void)AddAttributeDefinition(PERIOD_ATTRIBUTE_NAME, sup::dto::StringType);
+}
+
+PvAccessDiagnosticsVariable::~PvAccessDiagnosticsVariable() = default;
+
+PvAccessSharedServer& PvAccessDiagnosticsVariable::GetSharedServer() const
+{
+  if (m_workspace == nullptr)
+  {
+    throw InvalidOperationException(
+      "PvAccessDiagnosticsVariable::GetSharedServer(): Workspace is not set");
+  }
+  return pv_access_helper::GetSharedPvAccessServerRegistry().GetServer(m_workspace);
+}
+
+bool PvAccessDiagnosticsVariable::GetValueImpl(sup::dto::AnyValue& value) const
+{
+  auto diagnostics = GetSharedServer().GetValue(m_channel);
+  return !sup::dto::IsEmptyValue(diagnostics) &&
+         epics_helper::MoveOrAssign(value, std::move(diagnostics));
+}
+
+bool PvAccessDiagnosticsVariable::SetValueImpl(const sup::dto::AnyValue& value)
+{
+  // Diagnostics are read-only
+  (void)value;
+  return false;
+}
+
+bool PvAccessDiagnosticsVariable::IsAvailableImpl() const
+{
+  return !sup::dto::IsEmptyValue(GetSharedServer().GetValue(m_channel));
+}
+
+SetupTeardownActions PvAccessDiagnosticsVariable::SetupImpl(const Workspace& ws)
+{
+  double period_sec = DEFAULT_PERIOD_SEC;
+  if (HasAttribute(PERIOD_ATTRIBUTE_NAME))
+  {
+    auto period_attr_val = GetAttributeString(PERIOD_ATTRIBUTE_NAME);
+    if (!ParsePeriod(period_attr_val, period_sec))
+    {
+      std::string error_message = VariableSetupExceptionProlog(*this) +
+        "could not parse attribute [" + PERIOD_ATTRIBUTE_NAME + "] with value [" +
+        period_attr_val + "] as a positive number of seconds";
+      throw VariableSetupException(error_message);
+    }
+  }
+  m_workspace = std::addressof(ws);
+  m_channel = GetAttributeString(CHANNEL_ATTRIBUTE_NAME);
+  DiagnosticsProducer producer{};
+  auto start_value = producer();
+  auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>(period_sec));
+  GetSharedServer().AddPeriodicVariable(m_channel, start_value, period, producer);
+  // Use same key as standard PvAccess server variable:
+  SetupTeardownActions actions{
+    PvAccessServerVariable::Type,
+    [workspace = m_workspace]() {
+      pv_access_helper::GetSharedPvAccessServerRegistry().Setup(workspace);
+    },
+    [workspace = m_workspace]() {
+      pv_access_helper::GetSharedPvAccessServerRegistry().Teardown(workspace);
+    }
+  };
+  Notify(start_value, true);
+  return actions;
+}
+
+void PvAccessDiagnosticsVariable::TeardownImpl()
+{
+  m_channel.clear();
+  m_workspace = nullptr;
+}
+
+sup::dto::AnyType PluginDiagnosticsType()
+{
+  return sup::dto::AnyType{{
+    {"timestamp", sup::dto::UnsignedInteger64Type},
+    {"ca_channels", sup::dto::UnsignedInteger32Type},
+    {"pva_channels", sup::dto::UnsignedInteger32Type},
+    {"connected", sup::dto::UnsignedInteger32Type},
+    {"disconnected", sup::dto::UnsignedInteger32Type},
+    {"updates_received", sup::dto::UnsignedInteger64Type},
+    {"update_rate", sup::dto::Float64Type},
+    {"notify_count", sup::dto::UnsignedInteger64Type},
+    {"conversion_failures", sup::dto::UnsignedInteger64Type},
+    {"callbacks_in_progress", sup::dto::UnsignedInteger32Type},
+    {"outstanding_rpcs", sup::dto::UnsignedInteger32Type},
+    {"pending_connections", sup::dto::UnsignedInteger64Type},
+    {"time_to_all_connected", sup::dto::Float64Type},
+    {"pending_since", sup::dto::Float64Type},
+    {"skipped_writes", sup::dto::UnsignedInteger64Type},
+    {"prefetched_channels", sup::dto::UnsignedInteger64Type}
+  }, "sup::oacTreeEpicsDiagnostics/v1.0"};
+}
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+namespace
+{
+bool ParsePeriod(const std::string& period_str, double& period_sec)
+{
+  char* end = nullptr;
+  auto result = std::strtod(period_str.c_str(), &end);
+  if (end == period_str.c_str() || *end != '\0' || !(result > 0.0))
+  {
+    return false;
+  }
+  period_sec = result;
+  return true;
+}
+
+DiagnosticsProducer::DiagnosticsProducer()
+  : m_last_updates{0}
+  , m_last_time{}
+{}
+
+DiagnosticsProducer::~DiagnosticsProducer() = default;
+
+sup::dto::AnyValue DiagnosticsProducer::operator()()
+{
+  auto diagnostics = sup::oac_tree::epics_helper::CollectPluginDiagnostics();
+  auto now = std::chrono::steady_clock::now();
+  double update_rate = 0.0;
+  std::chrono::duration<double> elapsed = now - m_last_time;
+  // Counters restart when variables are torn down and set up again
+  if (m_last_time.time_since_epoch().count() != 0 && elapsed.count() > 0.0 &&
+      diagnostics.updates_received >= m_last_updates)
+  {
+    update_rate =
+      static_cast<double>(diagnostics.updates_received - m_last_updates) / elapsed.count();
+  }
+  m_last_updates = diagnostics.updates_received;
+  m_last_time = now;
+  return CreateDiagnosticsValue(diagnostics, update_rate);
+}
+
+sup::dto::AnyValue CreateDiagnosticsValue(
+  const sup::oac_tree::epics_helper::PluginDiagnostics& diagnostics, double update_rate)
+{
+  auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+  auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+  sup::dto::AnyValue result{sup::oac_tree::PluginDiagnosticsType()};
+  result["timestamp"] = static_cast<sup::dto::uint64>(timestamp);
+  result["ca_channels"] = diagnostics.ca_channels;
+  result["pva_channels"] = diagnostics.pva_channels;
+  result["connected"] = diagnostics.connected;
+  result["disconnected"] = diagnostics.disconnected;
+  result["updates_received"] = diagnostics.updates_received;
+  result["update_rate"] = update_rate;
+  result["notify_count"] = diagnostics.notify_count;
+  result["conversion_failures"] = diagnostics.conversion_failures;
+  result["callbacks_in_progress"] = diagnostics.callbacks_in_progress;
+  result["outstanding_rpcs"] = diagnostics.outstanding_rpcs;
+  result["pending_connections"] = diagnostics.pending_connections;
+  result["time_to_all_connected"] = diagnostics.time_to_all_connected;
+  result["pending_since"] = diagnostics.pending_since;
+  result["skipped_writes"] = diagnostics.skipped_writes;
+  result["prefetched_channels"] = diagnostics.prefetched_channels;
+  return result;
+}
+}  // unnamed namespace
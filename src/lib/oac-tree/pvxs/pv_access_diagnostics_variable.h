@@ -0,0 +1,81 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : CODAC Supervision and Automation (SUP) oac-tree component
+ *
+ * Description   : Variable plugin implementation
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_DIAGNOSTICS_VARIABLE_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_DIAGNOSTICS_VARIABLE_H_
+
+#include "pv_access_shared_server.h"
+
+#include <sup/oac-tree/variable.h>
+
+namespace sup
+{
+namespace oac_tree
+{
+/**
+ * @brief Read-only workspace variable that publishes the health of the EPICS plugins as a
+ * structured pvAccess channel, hosted by the same server as the PvAccessServer variables of the
+ * workspace. It has the following attributes:
+ * - channel: mandatory name of the published channel
+ * - period: optional publication period in seconds (default 1.0)
+ *
+ * The published structure contains the number of live CA and PVA channels, the number of
+ * connected and disconnected channels, the aggregated update count and rate, the number of
+ * variable callbacks in progress and the number of outstanding RPC calls.
+ * @code
+     <Workspace>
+       <PvAccessDiagnostics name="diagnostics"
+         channel="seq::plant-system::diagnostics"
+         period="2.0"/>
+     </Workspace>
+   @endcode
+ */
+class PvAccessDiagnosticsVariable : public Variable
+{
+public:
+  PvAccessDiagnosticsVariable();
+  ~PvAccessDiagnosticsVariable() override;
+
+  static const std::string Type;
+
+private:
+  PvAccessSharedServer& GetSharedServer() const;
+  bool GetValueImpl(sup::dto::AnyValue &value) const override;
+  bool SetValueImpl(const sup::dto::AnyValue &value) override;
+  bool IsAvailableImpl() const override;
+  SetupTeardownActions SetupImpl(const Workspace& ws) override;
+  void TeardownImpl() override;
+
+  std::string m_channel;
+  const Workspace* m_workspace;
+};
+
+/**
+ * @brief Type of the structure published by PvAccessDiagnosticsVariable.
+ */
+sup::dto::AnyType PluginDiagnosticsType();
+
+}  // namespace oac_tree
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_DIAGNOSTICS_VARIABLE_H_
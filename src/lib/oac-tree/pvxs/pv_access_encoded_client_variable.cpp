@@ -22,12 +22,17 @@
 
 #include "pv_access_encoded_client_variable.h"
 
+#include <oac-tree/common/plugin_diagnostics.h>
+#include <oac-tree/common/trace.h>
+
 #include <sup/oac-tree/variable_registry.h>
 
 #include <sup/dto/anyvalue_helper.h>
 #include <sup/epics/pv_access_client_pv.h>
 #include <sup/protocol/base64_variable_codec.h>
 
+#include <utility>
+
 namespace sup
 {
 namespace oac_tree
@@ -41,6 +46,7 @@ const std::string CHANNEL_ATTRIBUTE_NAME = "channel";
 
 PvAccessEncodedClientVariable::PvAccessEncodedClientVariable()
   : Variable(PvAccessEncodedClientVariable::Type)
+  , m_statistics{}
   , m_pv{}
 {
   (void)AddAttributeDefinition(CHANNEL_ATTRIBUTE_NAME, sup::dto::StringType).SetMandatory();
@@ -81,21 +87,44 @@ bool PvAccessEncodedClientVariable::IsAvailableImpl() const
 SetupTeardownActions PvAccessEncodedClientVariable::SetupImpl(const Workspace& ws)
 {
   (void)ws;
-  auto callback = [this](const epics::PvAccessClientPV::ExtendedValue& ext_value)
+  auto channel = GetAttributeString(CHANNEL_ATTRIBUTE_NAME);
+  m_statistics =
+    epics_helper::CreateVariableStatistics(PvAccessEncodedClientVariable::Type, channel);
+  auto callback = [this, statistics = m_statistics](
+                    const epics::PvAccessClientPV::ExtendedValue& ext_value)
   {
-    auto decoded = sup::protocol::Base64VariableCodec::Decode(ext_value.value);
+    epics_helper::ActiveCallbackGuard callback_guard;
+    epics_helper::TraceSpan callback_span{"PvAccessEncodedClient.monitor"};
+    statistics->SetConnected(ext_value.connected);
+    if (ext_value.connected)
+    {
+      // The size of the decoded payload is not fixed
+      statistics->RecordUpdate(0);
+    }
+    std::pair<bool, sup::dto::AnyValue> decoded;
+    {
+      epics_helper::TraceSpan decode_span{"PvAccessEncodedClient.decode"};
+      decoded = sup::protocol::Base64VariableCodec::Decode(ext_value.value);
+    }
+    if (ext_value.connected && !decoded.first)
+    {
+      statistics->RecordConversionFailure();
+    }
+    statistics->RecordNotify();
+    epics_helper::TraceSpan notify_span{"PvAccessEncodedClient.notify"};
     // Notify with empty value if decoding failed
     Notify(decoded.second, ext_value.connected);
     return;
   };
-  m_pv = std::make_unique<epics::PvAccessClientPV>(GetAttributeString(CHANNEL_ATTRIBUTE_NAME),
-                                                   callback);
+  m_pv = std::make_unique<epics::PvAccessClientPV>(channel, callback);
   return {};
 }
 
 void PvAccessEncodedClientVariable::TeardownImpl()
 {
   m_pv.reset();
+  epics_helper::FlushTrace();
+  m_statistics.reset();
 }
 
 }  // namespace oac_tree
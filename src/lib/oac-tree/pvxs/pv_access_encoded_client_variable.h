@@ -23,6 +23,8 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_ENCODED_CLIENT_VARIABLE_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_ENCODED_CLIENT_VARIABLE_H_
 
+#include <oac-tree/common/variable_statistics.h>
+
 #include <sup/oac-tree/variable.h>
 
 #include <memory>
@@ -64,6 +66,7 @@ private:
   SetupTeardownActions SetupImpl(const Workspace& ws) override;
   void TeardownImpl() override;
 
+  std::shared_ptr<epics_helper::VariableStatistics> m_statistics;
   std::unique_ptr<epics::PvAccessClientPV> m_pv;
 };
 
@@ -26,6 +26,9 @@
 #include "pv_access_helper.h"
 #include "pv_access_shared_server_registry.h"
 
+#include <oac-tree/common/plugin_diagnostics.h>
+#include <oac-tree/common/trace.h>
+
 #include <sup/oac-tree/concrete_constraints.h>
 #include <sup/oac-tree/exceptions.h>
 #include <sup/oac-tree/variable_registry.h>
@@ -36,6 +39,8 @@
 #include <sup/dto/json_value_parser.h>
 #include <sup/protocol/base64_variable_codec.h>
 
+#include <utility>
+
 namespace sup
 {
 namespace oac_tree
@@ -51,6 +56,7 @@ const std::string VALUE_ATTRIBUTE_NAME = "value";
 PvAccessEncodedServerVariable::PvAccessEncodedServerVariable()
   : Variable(PvAccessEncodedServerVariable::Type)
   , m_initial_type{}
+  , m_statistics{}
   , m_workspace{nullptr}
 {
   (void)AddAttributeDefinition(CHANNEL_ATTRIBUTE_NAME, sup::dto::StringType).SetMandatory();
@@ -110,16 +116,33 @@ SetupTeardownActions PvAccessEncodedServerVariable::SetupImpl(const Workspace& w
     m_initial_type = parser.MoveAnyType();
   }
   auto val = GetInitialValue(*this, m_initial_type);
-  auto callback = [this](const sup::dto::AnyValue& value)
+  auto channel = GetAttributeString(CHANNEL_ATTRIBUTE_NAME);
+  m_statistics =
+    epics_helper::CreateVariableStatistics(PvAccessEncodedServerVariable::Type, channel);
+  m_statistics->SetConnected(true);
+  auto callback = [this, statistics = m_statistics](const sup::dto::AnyValue& value)
   {
-    auto decoded = sup::protocol::Base64VariableCodec::Decode(value);
+    epics_helper::ActiveCallbackGuard callback_guard;
+    epics_helper::TraceSpan callback_span{"PvAccessEncodedServer.put"};
+    // The size of the decoded payload is not fixed
+    statistics->RecordUpdate(0);
+    std::pair<bool, sup::dto::AnyValue> decoded;
+    {
+      epics_helper::TraceSpan decode_span{"PvAccessEncodedServer.decode"};
+      decoded = sup::protocol::Base64VariableCodec::Decode(value);
+    }
+    if (!decoded.first)
+    {
+      statistics->RecordConversionFailure();
+    }
+    statistics->RecordNotify();
+    epics_helper::TraceSpan notify_span{"PvAccessEncodedServer.notify"};
     // Notify with empty value if decoding failed
     Notify(decoded.second, true);
     return;
   };
   auto encoded = sup::protocol::Base64VariableCodec::Encode(val);
-  GetSharedServer().AddVariable(GetAttributeString(CHANNEL_ATTRIBUTE_NAME), encoded.second,
-                                callback);
+  GetSharedServer().AddVariable(channel, encoded.second, callback);
   // Use same key as standard PvAccess server variable:
   SetupTeardownActions actions{
     PvAccessServerVariable::Type,
@@ -149,7 +172,9 @@ void PvAccessEncodedServerVariable::ResetImpl(const Workspace& ws)
 void PvAccessEncodedServerVariable::TeardownImpl()
 {
   m_initial_type = sup::dto::EmptyType;
+  m_statistics.reset();
   m_workspace = nullptr;
+  epics_helper::FlushTrace();
 }
 
 }  // namespace oac_tree
@@ -25,6 +25,8 @@
 
 #include "pv_access_shared_server.h"
 
+#include <oac-tree/common/variable_statistics.h>
+
 #include <sup/oac-tree/variable.h>
 
 #include <memory>
@@ -72,6 +74,7 @@ private:
   void TeardownImpl() override;
 
   sup::dto::AnyType m_initial_type;
+  std::shared_ptr<epics_helper::VariableStatistics> m_statistics;
   const Workspace* m_workspace;
 };
 
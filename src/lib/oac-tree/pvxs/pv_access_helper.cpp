@@ -59,6 +59,32 @@ sup::dto::AnyValue ConvertToTypedAnyValue(const sup::dto::AnyValue& value,
   return {};
 }
 
+sup::dto::AnyValue ConvertToTypedAnyValue(const sup::dto::AnyValue& value,
+                                          const sup::dto::AnyType& anytype,
+                                          epics_helper::ScalarConversion& conversion)
+{
+  if (sup::dto::IsScalarType(anytype) && value.HasField(VALUE_FIELD_NAME))
+  {
+    auto result = conversion.Convert(value[VALUE_FIELD_NAME]);
+    if (!sup::dto::IsEmptyValue(result))
+    {
+      return result;
+    }
+  }
+  return ConvertToTypedAnyValue(value, anytype);
+}
+
+sup::dto::AnyValue ConvertToTypedAnyValue(sup::dto::AnyValue&& value,
+                                          const sup::dto::AnyType& anytype)
+{
+  if (sup::dto::IsEmptyType(anytype) || value.GetType() == anytype)
+  {
+    return std::move(value);
+  }
+  const auto& const_value = value;
+  return ConvertToTypedAnyValue(const_value, anytype);
+}
+
 sup::dto::AnyValue PackIntoStructIfScalar(const sup::dto::AnyValue& value)
 {
   if (!sup::dto::IsScalarValue(value))
@@ -71,12 +97,82 @@ sup::dto::AnyValue PackIntoStructIfScalar(const sup::dto::AnyValue& value)
   return result;
 }
 
+sup::dto::AnyValue PackIntoStructIfScalar(sup::dto::AnyValue&& value)
+{
+  if (!sup::dto::IsScalarValue(value))
+  {
+    return std::move(value);
+  }
+  const auto& const_value = value;
+  return PackIntoStructIfScalar(const_value);
+}
+
+sup::dto::AnyValue CreateWireValue(const sup::dto::AnyType& anytype)
+{
+  return PackIntoStructIfScalar(sup::dto::AnyValue{anytype});
+}
+
+bool ConvertIntoWireValue(sup::dto::AnyValue& wire_value, const sup::dto::AnyType& anytype,
+                          const sup::dto::AnyValue& value)
+{
+  if (sup::dto::IsScalarType(anytype))
+  {
+    return sup::dto::TryConvert(wire_value[VALUE_FIELD_NAME], value);
+  }
+  return sup::dto::TryConvert(wire_value, value);
+}
+
+sup::dto::uint64 GetTimestamp(const sup::dto::AnyValue& value)
+{
+  if (!sup::dto::IsStructValue(value) || !value.HasField(TIMESTAMP_FIELD_NAME))
+  {
+    return 0;
+  }
+  const auto& timestamp = value[TIMESTAMP_FIELD_NAME];
+  sup::dto::AnyValue seconds{sup::dto::UnsignedInteger64Type};
+  sup::dto::AnyValue nanoseconds{sup::dto::UnsignedInteger64Type};
+  if (!sup::dto::IsStructValue(timestamp) || !timestamp.HasField(SECONDS_FIELD_NAME) ||
+      !timestamp.HasField(NANOSECONDS_FIELD_NAME) ||
+      !sup::dto::TryConvert(seconds, timestamp[SECONDS_FIELD_NAME]) ||
+      !sup::dto::TryConvert(nanoseconds, timestamp[NANOSECONDS_FIELD_NAME]))
+  {
+    return 0;
+  }
+  return seconds.As<sup::dto::uint64>() * 1000000000 + nanoseconds.As<sup::dto::uint64>();
+}
+
+bool HoldsValue(const sup::dto::AnyValue& remote, const sup::dto::AnyValue& value)
+{
+  if (remote == value)
+  {
+    return true;
+  }
+  if (!sup::dto::IsStructValue(remote) || !sup::dto::IsStructValue(value))
+  {
+    return false;
+  }
+  for (const auto& member_name : value.MemberNames())
+  {
+    if (!remote.HasField(member_name) || !HoldsValue(remote[member_name], value[member_name]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 PvAccessSharedServerRegistry& GetSharedPvAccessServerRegistry()
 {
   static PvAccessSharedServerRegistry shared_registry{};
   return shared_registry;
 }
 
+epics_helper::MonitorRegistry<sup::dto::AnyValue>& GetMonitorRegistry()
+{
+  static epics_helper::MonitorRegistry<sup::dto::AnyValue> monitor_registry{};
+  return monitor_registry;
+}
+
 }  // namespace pv_access_helper
 
 }  // namespace oac_tree
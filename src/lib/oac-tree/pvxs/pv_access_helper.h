@@ -23,6 +23,9 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_HELPER_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_HELPER_H_
 
+#include <oac-tree/common/monitor_registry.h>
+#include <oac-tree/common/scalar_conversion.h>
+
 #include <sup/dto/anyvalue.h>
 
 #include "pv_access_shared_server_registry.h"
@@ -41,15 +44,49 @@ const std::string SERVICE_ATTRIBUTE_NAME = "service";
 const std::string REQUEST_ATTRIBUTE_NAME = "requestVar";
 
 const std::string VALUE_FIELD_NAME = "value";
+const std::string TIMESTAMP_FIELD_NAME = "timeStamp";
+const std::string SECONDS_FIELD_NAME = "secondsPastEpoch";
+const std::string NANOSECONDS_FIELD_NAME = "nanoseconds";
 
 // Create an AnyValue of type 'anytype' from 'value'
 sup::dto::AnyValue ConvertToTypedAnyValue(const sup::dto::AnyValue& value,
                                           const sup::dto::AnyType& anytype);
 
+// Overload for updates of scalar variables that first tries the specialized scalar converter
+sup::dto::AnyValue ConvertToTypedAnyValue(const sup::dto::AnyValue& value,
+                                          const sup::dto::AnyType& anytype,
+                                          epics_helper::ScalarConversion& conversion);
+
+// Overload that moves 'value' into the result when no conversion is required
+sup::dto::AnyValue ConvertToTypedAnyValue(sup::dto::AnyValue&& value,
+                                          const sup::dto::AnyType& anytype);
+
 sup::dto::AnyValue PackIntoStructIfScalar(const sup::dto::AnyValue& value);
 
+// Overload that moves non-scalar values into the result
+sup::dto::AnyValue PackIntoStructIfScalar(sup::dto::AnyValue&& value);
+
+// Create the value that is sent over the wire for values of type 'anytype'. It is meant to be
+// kept and reused by ConvertIntoWireValue for every write.
+sup::dto::AnyValue CreateWireValue(const sup::dto::AnyType& anytype);
+
+// Convert 'value' in place into a wire value previously created for 'anytype'
+bool ConvertIntoWireValue(sup::dto::AnyValue& wire_value, const sup::dto::AnyType& anytype,
+                          const sup::dto::AnyValue& value);
+
+// Timestamp of a normative type value ('timeStamp' field) in ns since the UNIX epoch, or zero
+// when the value has no such field
+sup::dto::uint64 GetTimestamp(const sup::dto::AnyValue& value);
+
+// Check if writing 'value' to a channel holding 'remote' would change nothing: both are equal or
+// 'value' is a structure whose members are all held by the members of 'remote' with the same name
+bool HoldsValue(const sup::dto::AnyValue& remote, const sup::dto::AnyValue& value);
+
 PvAccessSharedServerRegistry& GetSharedPvAccessServerRegistry();
 
+// Live monitors of PvAccessClient variables, providing the unconverted values of their channel
+epics_helper::MonitorRegistry<sup::dto::AnyValue>& GetMonitorRegistry();
+
 }  // namespace pv_access_helper
 
 }  // namespace oac_tree
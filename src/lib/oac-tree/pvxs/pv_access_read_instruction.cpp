@@ -24,11 +24,15 @@
 
 #include "pv_access_helper.h"
 
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/trace.h>
+
 #include <sup/oac-tree/constants.h>
 #include <sup/oac-tree/exceptions.h>
 #include <sup/oac-tree/generic_utils.h>
 #include <sup/oac-tree/instruction_registry.h>
 #include <sup/oac-tree/instruction_utils.h>
+#include <sup/oac-tree/procedure.h>
 #include <sup/oac-tree/user_interface.h>
 #include <sup/oac-tree/workspace.h>
 
@@ -48,7 +52,10 @@ PvAccessReadInstruction::PvAccessReadInstruction()
   : Instruction(PvAccessReadInstruction::Type)
   , m_channel_name{}
   , m_finish{}
+  , m_monitored_value{}
   , m_pv{}
+  , m_wakeup{std::make_shared<epics_helper::WakeupSignal>()}
+  , m_prefetched{}
 {
   (void)AddAttributeDefinition(pv_access_helper::CHANNEL_ATTRIBUTE_NAME)
     .SetCategory(AttributeCategory::kBoth).SetMandatory();
@@ -56,12 +63,27 @@ PvAccessReadInstruction::PvAccessReadInstruction()
     .SetCategory(AttributeCategory::kVariableName).SetMandatory();
   (void)AddAttributeDefinition(Constants::TIMEOUT_SEC_ATTRIBUTE_NAME, sup::dto::Float64Type)
     .SetCategory(AttributeCategory::kBoth);
+  (void)AddAttributeDefinition(epics_helper::MAX_AGE_ATTRIBUTE_NAME, sup::dto::Float64Type)
+    .SetCategory(AttributeCategory::kBoth);
 }
 
 PvAccessReadInstruction::~PvAccessReadInstruction() = default;
 
+void PvAccessReadInstruction::SetupImpl(const Procedure& proc)
+{
+  (void)proc;
+  // Start connecting to literal channels already, so the first execution finds them connected
+  auto channel = GetAttributeString(pv_access_helper::CHANNEL_ATTRIBUTE_NAME);
+  m_prefetched.SetEnabled(!epics_helper::IsVariableReference(channel));
+  if (m_prefetched.IsEnabled())
+  {
+    m_prefetched.Store(channel, sup::dto::EmptyType, CreatePV(channel));
+  }
+}
+
 bool PvAccessReadInstruction::InitHook(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan init_span{"PvAccessRead.init"};
   if (!GetAttributeValueAs(pv_access_helper::CHANNEL_ATTRIBUTE_NAME, ws, ui, m_channel_name))
   {
     return false;
@@ -72,20 +94,70 @@ bool PvAccessReadInstruction::InitHook(UserInterface& ui, Workspace& ws)
   {
     return false;
   }
-  m_finish = utils::GetNanosecsSinceEpoch() + timeout_ns;
-  m_pv = std::make_unique<sup::epics::PvAccessClientPV>(m_channel_name);
+  sup::dto::float64 max_age_sec = 0.0;
+  sup::dto::uint64 max_age_ns = 0;
+  if (!GetAttributeValueAs(epics_helper::MAX_AGE_ATTRIBUTE_NAME, ws, ui, max_age_sec))
+  {
+    return false;
+  }
+  if (!epics_helper::SecondsToNanoseconds(max_age_sec, max_age_ns))
+  {
+    const std::string warning_message = InstructionWarningProlog(*this) +
+      "attribute [" + epics_helper::MAX_AGE_ATTRIBUTE_NAME + "] with value [" +
+      std::to_string(max_age_sec) + "] is not a valid age in seconds";
+    LogWarning(ui, warning_message);
+    return false;
+  }
+  auto now = utils::GetNanosecsSinceEpoch();
+  m_finish = now + timeout_ns;
+  // Use the value of a client variable that monitors the channel if its last update is recent
+  if (max_age_ns > 0 &&
+      pv_access_helper::GetMonitorRegistry().GetValue(m_channel_name, sup::dto::EmptyType,
+                                                      max_age_ns, now, m_monitored_value) &&
+      !sup::dto::IsEmptyValue(m_monitored_value))
+  {
+    return true;
+  }
+  m_pv = m_prefetched.Take(m_channel_name, sup::dto::EmptyType);
+  if (!m_pv)
+  {
+    m_pv = CreatePV(m_channel_name);
+  }
   return true;
 }
 
 ExecutionStatus PvAccessReadInstruction::ExecuteSingleImpl(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan poll_span{"PvAccessRead.poll"};
   if (IsHaltRequested())
   {
     return ExecutionStatus::FAILURE;
   }
-  auto now = utils::GetNanosecsSinceEpoch();
+  if (!m_pv)
+  {
+    // InitHook took a valid value from a live monitor of the channel
+    epics_helper::TraceInstant("PvAccessRead.monitored");
+    if (!SetValueFromAttributeName(*this, ws, ui, Constants::OUTPUT_VARIABLE_NAME_ATTRIBUTE_NAME,
+                                   m_monitored_value))
+    {
+      return ExecutionStatus::FAILURE;
+    }
+    return ExecutionStatus::SUCCESS;
+  }
+  auto wakeup_count = m_wakeup->GetCount();
   auto ext_val = m_pv->GetExtendedValue();
   if (!ext_val.connected || sup::dto::IsEmptyValue(ext_val.value))
+  {
+    // Wait (bounded) for the channel to connect instead of returning to be polled again
+    (void)m_wakeup->WaitForSignal(wakeup_count, m_finish);
+    if (IsHaltRequested())
+    {
+      return ExecutionStatus::FAILURE;
+    }
+    ext_val = m_pv->GetExtendedValue();
+  }
+  auto now = utils::GetNanosecsSinceEpoch();
+  if (!ext_val.connected || sup::dto::IsEmptyValue(ext_val.value))
   {
     if (m_finish > now)
     {
@@ -96,6 +168,7 @@ ExecutionStatus PvAccessReadInstruction::ExecuteSingleImpl(UserInterface& ui, Wo
     LogWarning(ui, warning_message);
     return ExecutionStatus::FAILURE;
   }
+  epics_helper::TraceInstant("PvAccessRead.connected");
   if (!SetValueFromAttributeName(*this, ws, ui, Constants::OUTPUT_VARIABLE_NAME_ATTRIBUTE_NAME, ext_val.value))
   {
     return ExecutionStatus::FAILURE;
@@ -106,14 +179,29 @@ ExecutionStatus PvAccessReadInstruction::ExecuteSingleImpl(UserInterface& ui, Wo
 void PvAccessReadInstruction::ResetHook(UserInterface& ui)
 {
   Halt(ui);
+  m_finish = 0;
+  m_channel_name = "";
+  m_monitored_value = sup::dto::AnyValue{};
+  // Do not keep the channel and its monitor of an instruction that may not run again
+  m_pv.reset();
+  m_prefetched.Clear();
 }
 
 void PvAccessReadInstruction::HaltImpl(UserInterface& ui)
 {
   (void)ui;
-  m_channel_name = "";
-  m_finish = 0;
-  m_pv.reset();
+  // Only wake up a waiting execution: it may still use the channel until it sees the halt request,
+  // so the channel is released on reset
+  m_wakeup->Signal();
+}
+
+std::unique_ptr<sup::epics::PvAccessClientPV> PvAccessReadInstruction::CreatePV(
+  const std::string& channel) const
+{
+  auto callback = [wakeup = m_wakeup](const sup::epics::PvAccessClientPV::ExtendedValue&) {
+    wakeup->Signal();
+  };
+  return std::make_unique<sup::epics::PvAccessClientPV>(channel, callback);
 }
 
 } // namespace oac_tree
@@ -23,8 +23,13 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_READ_INSTRUCTION_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_READ_INSTRUCTION_H_
 
+#include <oac-tree/common/prefetched_channel.h>
+#include <oac-tree/common/wakeup_signal.h>
+
 #include <sup/oac-tree/instruction.h>
 
+#include <sup/dto/anyvalue.h>
+
 #include <memory>
 
 namespace sup
@@ -60,6 +65,13 @@ namespace oac_tree
          value="false"/>
      </Workspace>
    @endcode
+ *
+ * @note When the 'channel' attribute is a literal name, the channel is created during procedure
+ * setup, so it is usually connected by the time the instruction first runs. The channel holds a
+ * monitor on the server until the instruction is reset.
+ * @note With the optional 'maxAge' attribute (seconds), the instruction takes the value from a
+ * PvAccessClient variable that monitors the same channel, if it received its last update at most
+ * 'maxAge' seconds ago. No channel is then accessed.
  */
 class PvAccessReadInstruction : public Instruction
 {
@@ -72,7 +84,12 @@ public:
 private:
   std::string m_channel_name;
   sup::dto::uint64 m_finish;
+  sup::dto::AnyValue m_monitored_value;
   std::unique_ptr<sup::epics::PvAccessClientPV> m_pv;
+  std::shared_ptr<epics_helper::WakeupSignal> m_wakeup;
+  epics_helper::PrefetchedChannel<sup::epics::PvAccessClientPV> m_prefetched;
+
+  void SetupImpl(const Procedure& proc) override;
 
   bool InitHook(UserInterface& ui, Workspace& ws) override;
 
@@ -81,6 +98,8 @@ private:
   void ResetHook(UserInterface& ui) override;
 
   void HaltImpl(UserInterface& ui) override;
+
+  std::unique_ptr<sup::epics::PvAccessClientPV> CreatePV(const std::string& channel) const;
 };
 
 }  // namespace oac_tree
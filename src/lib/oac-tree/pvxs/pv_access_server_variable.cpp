@@ -25,6 +25,10 @@
 #include "pv_access_helper.h"
 #include "pv_access_shared_server_registry.h"
 
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/plugin_diagnostics.h>
+#include <oac-tree/common/trace.h>
+
 #include <sup/oac-tree/exceptions.h>
 #include <sup/oac-tree/variable_registry.h>
 #include <sup/oac-tree/workspace.h>
@@ -48,6 +52,12 @@ const std::string VALUE_ATTRIBUTE_NAME = "value";
 PvAccessServerVariable::PvAccessServerVariable()
   : Variable(PvAccessServerVariable::Type)
   , m_anytype{}
+  , m_channel{}
+  , m_wire_value{}
+  , m_wire_mutex{}
+  , m_scalar_conversion{}
+  , m_payload_size{0}
+  , m_statistics{}
   , m_workspace{nullptr}
 {
   (void)AddAttributeDefinition(CHANNEL_ATTRIBUTE_NAME, sup::dto::StringType).SetMandatory();
@@ -69,32 +79,35 @@ PvAccessSharedServer& PvAccessServerVariable::GetSharedServer() const
 
 bool PvAccessServerVariable::GetValueImpl(sup::dto::AnyValue& value) const
 {
-  auto converted_val = pv_access_helper::ConvertToTypedAnyValue(
-    GetSharedServer().GetValue(GetAttributeString(CHANNEL_ATTRIBUTE_NAME)), m_anytype);
-  return !sup::dto::IsEmptyValue(converted_val) && sup::dto::TryAssign(value, converted_val);
+  auto converted_val =
+    pv_access_helper::ConvertToTypedAnyValue(GetSharedServer().GetValue(m_channel), m_anytype);
+  return !sup::dto::IsEmptyValue(converted_val) &&
+         epics_helper::MoveOrAssign(value, std::move(converted_val));
 }
 
 bool PvAccessServerVariable::SetValueImpl(const sup::dto::AnyValue& value)
 {
-  sup::dto::AnyValue copy(m_anytype);
-  if (!sup::dto::TryConvert(copy, value))
+  if (!sup::dto::IsScalarValue(value) && value.GetType() == m_anytype)
   {
-    return false;
+    // No conversion or wrapping structure needed: pass the value without copying it
+    return GetSharedServer().SetValue(m_channel, value);
   }
-  return GetSharedServer().SetValue(GetAttributeString(CHANNEL_ATTRIBUTE_NAME),
-                                    pv_access_helper::PackIntoStructIfScalar(copy));
+  std::lock_guard<std::mutex> lk{m_wire_mutex};
+  return pv_access_helper::ConvertIntoWireValue(m_wire_value, m_anytype, value) &&
+         GetSharedServer().SetValue(m_channel, m_wire_value);
 }
 
 bool PvAccessServerVariable::IsAvailableImpl() const
 {
-  auto value = pv_access_helper::ConvertToTypedAnyValue(
-    GetSharedServer().GetValue(GetAttributeString(CHANNEL_ATTRIBUTE_NAME)), m_anytype);
+  auto value =
+    pv_access_helper::ConvertToTypedAnyValue(GetSharedServer().GetValue(m_channel), m_anytype);
   return !sup::dto::IsEmptyValue(value);
 }
 
 SetupTeardownActions PvAccessServerVariable::SetupImpl(const Workspace& ws)
 {
   m_workspace = std::addressof(ws);
+  m_channel = GetAttributeString(CHANNEL_ATTRIBUTE_NAME);
   sup::dto::JSONAnyTypeParser parser;
   auto type_attr_val = GetAttributeString(TYPE_ATTRIBUTE_NAME);
   const auto& registry = ws.GetTypeRegistry();
@@ -111,17 +124,36 @@ SetupTeardownActions PvAccessServerVariable::SetupImpl(const Workspace& ws)
       "empty type is not allowed for this type of variable";
     throw VariableSetupException(error_message);
   }
+  m_wire_value = pv_access_helper::CreateWireValue(m_anytype);
+  m_scalar_conversion = epics_helper::ScalarConversion{m_anytype};
+  m_payload_size = epics_helper::FixedPayloadSize(m_anytype);
+  m_statistics = epics_helper::CreateVariableStatistics(PvAccessServerVariable::Type, m_channel);
+  m_statistics->SetConnected(true);
   auto val = GetInitialValue(*this, m_anytype);
-  // Avoid dependence on destruction order of m_server and m_anytype.
-  auto callback = [this](const sup::dto::AnyValue& value)
+  // Avoid dependence on destruction order of m_server and m_anytype. The statistics are shared
+  // with the callback, as the shared server may outlive the setup of this variable.
+  auto callback = [this, statistics = m_statistics](const sup::dto::AnyValue& value)
   {
-    auto typed_value = pv_access_helper::ConvertToTypedAnyValue(value, m_anytype);
+    epics_helper::ActiveCallbackGuard callback_guard;
+    epics_helper::TraceSpan callback_span{"PvAccessServer.put"};
+    statistics->RecordUpdate(m_payload_size);
+    sup::dto::AnyValue typed_value;
+    {
+      epics_helper::TraceSpan conversion_span{"PvAccessServer.convert"};
+      typed_value =
+        pv_access_helper::ConvertToTypedAnyValue(value, m_anytype, m_scalar_conversion);
+    }
+    if (sup::dto::IsEmptyValue(typed_value))
+    {
+      statistics->RecordConversionFailure();
+    }
+    statistics->RecordNotify();
+    epics_helper::TraceSpan notify_span{"PvAccessServer.notify"};
     Notify(typed_value, true);
     return;
   };
   auto start_value = pv_access_helper::PackIntoStructIfScalar(val);
-  GetSharedServer().AddVariable(GetAttributeString(CHANNEL_ATTRIBUTE_NAME), start_value,
-                                callback);
+  GetSharedServer().AddVariable(m_channel, start_value, callback);
   SetupTeardownActions actions{
     PvAccessServerVariable::Type,
     [workspace = m_workspace]() {
@@ -143,14 +175,19 @@ void PvAccessServerVariable::ResetImpl(const Workspace& ws)
     return;
   }
   auto val = GetInitialValue(*this, m_anytype);
-  (void)GetSharedServer().SetValue(GetAttributeString(CHANNEL_ATTRIBUTE_NAME),
-              pv_access_helper::PackIntoStructIfScalar(val));
+  (void)GetSharedServer().SetValue(m_channel, pv_access_helper::PackIntoStructIfScalar(val));
 }
 
 void PvAccessServerVariable::TeardownImpl()
 {
   m_anytype = sup::dto::EmptyType;
+  m_channel.clear();
+  m_wire_value = sup::dto::AnyValue{};
+  m_scalar_conversion = epics_helper::ScalarConversion{};
+  m_payload_size = 0;
+  m_statistics.reset();
   m_workspace = nullptr;
+  epics_helper::FlushTrace();
 }
 
 sup::dto::AnyValue GetInitialValue(const Variable& variable, const sup::dto::AnyType& val_type)
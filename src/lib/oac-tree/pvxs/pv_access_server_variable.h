@@ -25,9 +25,13 @@
 
 #include "pv_access_shared_server.h"
 
+#include <oac-tree/common/scalar_conversion.h>
+#include <oac-tree/common/variable_statistics.h>
+
 #include <sup/oac-tree/variable.h>
 
 #include <memory>
+#include <mutex>
 
 namespace sup
 {
@@ -68,6 +72,12 @@ private:
   void TeardownImpl() override;
 
   sup::dto::AnyType m_anytype;
+  std::string m_channel;
+  sup::dto::AnyValue m_wire_value;
+  std::mutex m_wire_mutex;
+  epics_helper::ScalarConversion m_scalar_conversion;
+  std::size_t m_payload_size;
+  std::shared_ptr<epics_helper::VariableStatistics> m_statistics;
   const Workspace* m_workspace;
 };
 
@@ -24,6 +24,8 @@
 
 #include <sup/epics/pv_access_server.h>
 
+#include <algorithm>
+
 namespace sup
 {
 namespace oac_tree
@@ -31,9 +33,18 @@ namespace oac_tree
 
 PvAccessSharedServer::PvAccessSharedServer()
   : m_server{}
+  , m_var_callbacks{}
+  , m_periodic_vars{}
+  , m_periodic_mtx{}
+  , m_periodic_cv{}
+  , m_periodic_halt{false}
+  , m_periodic_thread{}
 {}
 
-PvAccessSharedServer::~PvAccessSharedServer() = default;
+PvAccessSharedServer::~PvAccessSharedServer()
+{
+  StopPeriodicUpdates();
+}
 
 void PvAccessSharedServer::AddVariable(const std::string& name, const sup::dto::AnyValue& start_val,
                                        VariableCallback cb)
@@ -43,6 +54,16 @@ void PvAccessSharedServer::AddVariable(const std::string& name, const sup::dto::
   m_var_callbacks[name] = cb;
 }
 
+void PvAccessSharedServer::AddPeriodicVariable(const std::string& name,
+                                               const sup::dto::AnyValue& start_val,
+                                               std::chrono::nanoseconds period,
+                                               ValueProducer producer)
+{
+  EnsureServer();
+  m_server->AddVariable(name, start_val);
+  m_periodic_vars.push_back({name, period, std::move(producer), {}});
+}
+
 sup::dto::AnyValue PvAccessSharedServer::GetValue(const std::string& name)
 {
   return m_server->GetValue(name);
@@ -57,10 +78,13 @@ void PvAccessSharedServer::Setup()
 {
   EnsureServer();
   m_server->Start();
+  StartPeriodicUpdates();
 }
 
 void PvAccessSharedServer::Teardown()
 {
+  // Periodic updates use the server, so they are stopped first
+  StopPeriodicUpdates();
   m_server.reset();
 }
 
@@ -86,6 +110,55 @@ void PvAccessSharedServer::DelegateCallbacks(const std::string& name,
   iter->second(value);
 }
 
+void PvAccessSharedServer::StartPeriodicUpdates()
+{
+  if (m_periodic_vars.empty() || m_periodic_thread.joinable())
+  {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  for (auto& periodic_var : m_periodic_vars)
+  {
+    periodic_var.next_update = now + periodic_var.period;
+  }
+  m_periodic_halt = false;
+  m_periodic_thread = std::thread(&PvAccessSharedServer::PeriodicUpdateLoop, this);
+}
+
+void PvAccessSharedServer::StopPeriodicUpdates()
+{
+  if (!m_periodic_thread.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lk{m_periodic_mtx};
+    m_periodic_halt = true;
+  }
+  m_periodic_cv.notify_one();
+  m_periodic_thread.join();
+}
+
+void PvAccessSharedServer::PeriodicUpdateLoop()
+{
+  std::unique_lock<std::mutex> lk{m_periodic_mtx};
+  while (!m_periodic_halt)
+  {
+    auto now = std::chrono::steady_clock::now();
+    auto next_update = std::chrono::steady_clock::time_point::max();
+    for (auto& periodic_var : m_periodic_vars)
+    {
+      if (periodic_var.next_update <= now)
+      {
+        (void)m_server->SetValue(periodic_var.name, periodic_var.producer());
+        periodic_var.next_update = now + periodic_var.period;
+      }
+      next_update = std::min(next_update, periodic_var.next_update);
+    }
+    (void)m_periodic_cv.wait_until(lk, next_update, [this]() { return m_periodic_halt; });
+  }
+}
+
 }  // namespace oac_tree
 
 }  // namespace sup
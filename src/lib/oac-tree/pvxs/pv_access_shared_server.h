@@ -25,8 +25,14 @@
 
 #include <sup/dto/anyvalue.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace sup
 {
@@ -41,6 +47,7 @@ class PvAccessSharedServer
 {
 public:
   using VariableCallback = std::function<void(const sup::dto::AnyValue& val)>;
+  using ValueProducer = std::function<sup::dto::AnyValue()>;
 
   PvAccessSharedServer();
   ~PvAccessSharedServer();
@@ -48,6 +55,13 @@ public:
   void AddVariable(const std::string& name, const sup::dto::AnyValue& start_val,
                    VariableCallback cb);
 
+  /**
+   * @brief Add a variable whose value is periodically replaced by the result of 'producer', from
+   * a thread that runs while the server is set up.
+   */
+  void AddPeriodicVariable(const std::string& name, const sup::dto::AnyValue& start_val,
+                           std::chrono::nanoseconds period, ValueProducer producer);
+
   sup::dto::AnyValue GetValue(const std::string& name);
 
   bool SetValue(const std::string& name, const sup::dto::AnyValue& value);
@@ -57,10 +71,25 @@ public:
   void Teardown();
 
 private:
+  struct PeriodicVariable
+  {
+    std::string name;
+    std::chrono::nanoseconds period;
+    ValueProducer producer;
+    std::chrono::steady_clock::time_point next_update;
+  };
   void EnsureServer();
   void DelegateCallbacks(const std::string&, const sup::dto::AnyValue& value);
+  void StartPeriodicUpdates();
+  void StopPeriodicUpdates();
+  void PeriodicUpdateLoop();
   std::unique_ptr<epics::PvAccessServer> m_server;
   std::map<std::string, VariableCallback> m_var_callbacks;
+  std::vector<PeriodicVariable> m_periodic_vars;
+  std::mutex m_periodic_mtx;
+  std::condition_variable m_periodic_cv;
+  bool m_periodic_halt;
+  std::thread m_periodic_thread;
 };
 
 }  // namespace oac_tree
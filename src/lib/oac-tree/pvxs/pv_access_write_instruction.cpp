@@ -24,6 +24,10 @@
 
 #include "pv_access_helper.h"
 
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/plugin_diagnostics.h>
+#include <oac-tree/common/trace.h>
+
 #include <sup/oac-tree/constants.h>
 #include <sup/oac-tree/concrete_constraints.h>
 #include <sup/oac-tree/exceptions.h>
@@ -38,6 +42,7 @@
 #include <sup/dto/anyvalue_helper.h>
 #include <sup/epics/pv_access_client_pv.h>
 
+
 namespace sup {
 
 namespace oac_tree {
@@ -49,6 +54,12 @@ static const bool pv_access_write_instruction_initialised_flag =
 
 PvAccessWriteInstruction::PvAccessWriteInstruction()
   : Instruction(PvAccessWriteInstruction::Type)
+  , m_channel_name{}
+  , m_finish{}
+  , m_only_if_changed{false}
+  , m_pv{}
+  , m_wakeup{std::make_shared<epics_helper::WakeupSignal>()}
+  , m_prefetched{}
 {
   (void)AddAttributeDefinition(pv_access_helper::CHANNEL_ATTRIBUTE_NAME)
     .SetCategory(AttributeCategory::kBoth).SetMandatory();
@@ -58,6 +69,9 @@ PvAccessWriteInstruction::PvAccessWriteInstruction()
   (void)AddAttributeDefinition(Constants::VALUE_ATTRIBUTE_NAME);
   (void)AddAttributeDefinition(Constants::TIMEOUT_SEC_ATTRIBUTE_NAME, sup::dto::Float64Type)
     .SetCategory(AttributeCategory::kBoth);
+  (void)AddAttributeDefinition(epics_helper::ONLY_IF_CHANGED_ATTRIBUTE_NAME,
+                               sup::dto::BooleanType)
+    .SetCategory(AttributeCategory::kBoth);
   AddConstraint(MakeConstraint<Xor>(
     MakeConstraint<Exists>(Constants::GENERIC_VARIABLE_NAME_ATTRIBUTE_NAME),
     MakeConstraint<And>(MakeConstraint<Exists>(Constants::TYPE_ATTRIBUTE_NAME),
@@ -66,8 +80,21 @@ PvAccessWriteInstruction::PvAccessWriteInstruction()
 
 PvAccessWriteInstruction::~PvAccessWriteInstruction() = default;
 
+void PvAccessWriteInstruction::SetupImpl(const Procedure& proc)
+{
+  (void)proc;
+  // Start connecting to literal channels already, so the first execution finds them connected
+  auto channel = GetAttributeString(pv_access_helper::CHANNEL_ATTRIBUTE_NAME);
+  m_prefetched.SetEnabled(!epics_helper::IsVariableReference(channel));
+  if (m_prefetched.IsEnabled())
+  {
+    m_prefetched.Store(channel, sup::dto::EmptyType, CreatePV(channel));
+  }
+}
+
 bool PvAccessWriteInstruction::InitHook(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan init_span{"PvAccessWrite.init"};
   if (!GetAttributeValueAs(pv_access_helper::CHANNEL_ATTRIBUTE_NAME, ws, ui, m_channel_name))
   {
     return false;
@@ -78,13 +105,24 @@ bool PvAccessWriteInstruction::InitHook(UserInterface& ui, Workspace& ws)
   {
     return false;
   }
+  m_only_if_changed = false;
+  if (!GetAttributeValueAs(epics_helper::ONLY_IF_CHANGED_ATTRIBUTE_NAME, ws, ui,
+                           m_only_if_changed))
+  {
+    return false;
+  }
   m_finish = utils::GetNanosecsSinceEpoch() + timeout_ns;
-  m_pv = std::make_unique<sup::epics::PvAccessClientPV>(m_channel_name);
+  m_pv = m_prefetched.Take(m_channel_name, sup::dto::EmptyType);
+  if (!m_pv)
+  {
+    m_pv = CreatePV(m_channel_name);
+  }
   return true;
 }
 
 ExecutionStatus PvAccessWriteInstruction::ExecuteSingleImpl(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan poll_span{"PvAccessWrite.poll"};
   auto value = pv_access_helper::PackIntoStructIfScalar(GetNewValue(ui, ws));
   if (sup::dto::IsEmptyValue(value))
   {
@@ -94,8 +132,20 @@ ExecutionStatus PvAccessWriteInstruction::ExecuteSingleImpl(UserInterface& ui, W
   {
     return ExecutionStatus::FAILURE;
   }
+  auto wakeup_count = m_wakeup->GetCount();
+  auto connected = m_pv->IsConnected();
+  if (!connected)
+  {
+    // Wait (bounded) for the channel to connect instead of returning to be polled again
+    (void)m_wakeup->WaitForSignal(wakeup_count, m_finish);
+    if (IsHaltRequested())
+    {
+      return ExecutionStatus::FAILURE;
+    }
+    connected = m_pv->IsConnected();
+  }
   auto now = utils::GetNanosecsSinceEpoch();
-  if (!m_pv->IsConnected())
+  if (!connected)
   {
     if (m_finish > now)
     {
@@ -106,6 +156,13 @@ ExecutionStatus PvAccessWriteInstruction::ExecuteSingleImpl(UserInterface& ui, W
     LogWarning(ui, warning_message);
     return ExecutionStatus::FAILURE;
   }
+  epics_helper::TraceInstant("PvAccessWrite.connected");
+  if (m_only_if_changed && ChannelHoldsValue(value))
+  {
+    epics_helper::TraceInstant("PvAccessWrite.skipped");
+    epics_helper::RecordSkippedWrite();
+    return ExecutionStatus::SUCCESS;
+  }
   if (!m_pv->SetValue(value))
   {
     auto json_value = sup::dto::ValuesToJSONString(value).substr(0, 1024);
@@ -120,14 +177,47 @@ ExecutionStatus PvAccessWriteInstruction::ExecuteSingleImpl(UserInterface& ui, W
 void PvAccessWriteInstruction::ResetHook(UserInterface& ui)
 {
   Halt(ui);
+  m_finish = 0;
+  m_channel_name = "";
+  m_only_if_changed = false;
+  // Do not keep the channel and its monitor of an instruction that may not run again
+  m_pv.reset();
+  m_prefetched.Clear();
 }
 
 void PvAccessWriteInstruction::HaltImpl(UserInterface& ui)
 {
   (void)ui;
-  m_channel_name = "";
-  m_finish = 0;
-  m_pv.reset();
+  // Only wake up a waiting execution: it may still use the channel until it sees the halt request,
+  // so the channel is released on reset
+  m_wakeup->Signal();
+}
+
+std::unique_ptr<sup::epics::PvAccessClientPV> PvAccessWriteInstruction::CreatePV(
+  const std::string& channel) const
+{
+  auto callback = [wakeup = m_wakeup](const sup::epics::PvAccessClientPV::ExtendedValue&) {
+    wakeup->Signal();
+  };
+  return std::make_unique<sup::epics::PvAccessClientPV>(channel, callback);
+}
+
+bool PvAccessWriteInstruction::ChannelHoldsValue(const sup::dto::AnyValue& value) const
+{
+  auto ext_val = m_pv->GetExtendedValue();
+  auto remote = std::move(ext_val.value);
+  if (!ext_val.connected || sup::dto::IsEmptyValue(remote))
+  {
+    // Its first update did not arrive yet: use a recent update of a client variable monitor
+    auto now = utils::GetNanosecsSinceEpoch();
+    if (!pv_access_helper::GetMonitorRegistry().GetValue(
+            m_channel_name, sup::dto::EmptyType, epics_helper::ONLY_IF_CHANGED_MAX_AGE_NS, now,
+            remote) || sup::dto::IsEmptyValue(remote))
+    {
+      return false;
+    }
+  }
+  return pv_access_helper::HoldsValue(remote, value);
 }
 
 sup::dto::AnyValue PvAccessWriteInstruction::GetNewValue(UserInterface& ui, Workspace& ws) const
@@ -23,6 +23,9 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_WRITE_INSTRUCTION_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_PV_ACCESS_WRITE_INSTRUCTION_H_
 
+#include <oac-tree/common/prefetched_channel.h>
+#include <oac-tree/common/wakeup_signal.h>
+
 #include <sup/oac-tree/instruction.h>
 
 #include <memory>
@@ -61,6 +64,18 @@ namespace oac_tree
          value="false"/>
      </Workspace>
    @endcode
+ *
+ * @note When the 'channel' attribute is a literal name, the channel is created during procedure
+ * setup, so it is usually connected by the time the instruction first runs. The channel holds a
+ * monitor on the server until the instruction is reset.
+ * @note With onlyIfChanged="true", the instruction succeeds without writing when the channel
+ * already holds the value, i.e. when all fields to write have the same type and value in the
+ * channel (see pv_access_helper::HoldsValue). The remote value is taken from the monitor of the
+ * instruction's own channel or else from a connected PvAccessClient variable with the same channel
+ * whose last update is at most 10 seconds old (see pv_access_helper::GetMonitorRegistry). Skipped
+ * writes are counted in the plugin diagnostics. The comparison is approximate: for channels served
+ * by an IOC, a monitor only receives value changes larger than the deadband (MDEL) of the record,
+ * so a put whose value differs from the monitored value by less than the deadband may be skipped.
  */
 class PvAccessWriteInstruction : public Instruction
 {
@@ -73,7 +88,12 @@ public:
 private:
   std::string m_channel_name;
   sup::dto::uint64 m_finish;
+  bool m_only_if_changed;
   std::unique_ptr<sup::epics::PvAccessClientPV> m_pv;
+  std::shared_ptr<epics_helper::WakeupSignal> m_wakeup;
+  epics_helper::PrefetchedChannel<sup::epics::PvAccessClientPV> m_prefetched;
+
+  void SetupImpl(const Procedure& proc) override;
 
   bool InitHook(UserInterface& ui, Workspace& ws) override;
 
@@ -83,7 +103,11 @@ private:
 
   void HaltImpl(UserInterface& ui) override;
 
+  std::unique_ptr<sup::epics::PvAccessClientPV> CreatePV(const std::string& channel) const;
+
   sup::dto::AnyValue GetNewValue(UserInterface& ui, Workspace& ws) const;
+
+  bool ChannelHoldsValue(const sup::dto::AnyValue& value) const;
 };
 
 }  // namespace oac_tree
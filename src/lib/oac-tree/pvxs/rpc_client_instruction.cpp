@@ -23,9 +23,13 @@
 #include "rpc_client_instruction.h"
 #include "pv_access_helper.h"
 
+#include <oac-tree/common/plugin_diagnostics.h>
+#include <oac-tree/common/trace.h>
+
 #include <sup/oac-tree/concrete_constraints.h>
 #include <sup/oac-tree/constants.h>
 #include <sup/oac-tree/exceptions.h>
+#include <sup/oac-tree/generic_utils.h>
 #include <sup/oac-tree/instruction.h>
 #include <sup/oac-tree/instruction_registry.h>
 #include <sup/oac-tree/procedure.h>
@@ -36,10 +40,14 @@
 #include <sup/epics/pv_access_rpc_client.h>
 #include <sup/protocol/protocol_rpc.h>
 
+#include <exception>
 #include <thread>
 
 namespace
 {
+// The client replies itself when its timeout expires: give that reply time to arrive
+const sup::dto::uint64 REPLY_TIMEOUT_MARGIN_NS = 1000000000;  // 1 second
+
 bool IsSuccessfulReply(sup::dto::AnyValue reply);
 }  // unnamed namespace
 
@@ -55,6 +63,8 @@ static const bool rpcclient_instruction_initialised_flag =
 RPCClientInstruction::RPCClientInstruction()
   : Instruction(RPCClientInstruction::Type)
   , m_future{}
+  , m_wakeup{std::make_shared<epics_helper::WakeupSignal>()}
+  , m_finish{0}
 {
   (void)AddAttributeDefinition(pv_access_helper::SERVICE_ATTRIBUTE_NAME)
     .SetCategory(AttributeCategory::kBoth).SetMandatory();
@@ -76,6 +86,7 @@ RPCClientInstruction::~RPCClientInstruction() = default;
 
 bool RPCClientInstruction::InitHook(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan init_span{"RPCClient.init"};
   auto request = GetRequest(ui, ws);
   if (sup::dto::IsEmptyValue(request))
   {
@@ -100,27 +111,80 @@ bool RPCClientInstruction::InitHook(UserInterface& ui, Workspace& ws)
     return false;
   }
   client_config.timeout = timeout_sec;
-  auto task = [client_config, request]() {
-    sup::epics::PvAccessRPCClient rpc_client(client_config);
-    return rpc_client(request);
+  m_finish = utils::GetNanosecsSinceEpoch() + static_cast<sup::dto::uint64>(timeout_sec * 1e9) +
+             REPLY_TIMEOUT_MARGIN_NS;
+  std::promise<sup::dto::AnyValue> reply_promise;
+  m_future = reply_promise.get_future();
+  // The reply is stored before signalling, so a woken up instruction always finds it ready
+  auto task = [client_config, request, reply_promise = std::move(reply_promise),
+               wakeup = m_wakeup]() mutable {
+    {
+      epics_helper::OutstandingRPCGuard rpc_guard;
+      epics_helper::TraceSpan request_span{"RPCClient.request"};
+      try
+      {
+        sup::epics::PvAccessRPCClient rpc_client(client_config);
+        reply_promise.set_value(rpc_client(request));
+      }
+      catch (...)
+      {
+        reply_promise.set_exception(std::current_exception());
+      }
+    }
+    wakeup->Signal();
   };
-  std::packaged_task<sup::dto::AnyValue()> task_wrapper(std::move(task));
-  m_future = task_wrapper.get_future();
-  std::thread(std::move(task_wrapper)).detach();
+  std::thread(std::move(task)).detach();
   return true;
 }
 
 ExecutionStatus RPCClientInstruction::ExecuteSingleImpl(UserInterface& ui, Workspace& ws)
 {
+  epics_helper::TraceSpan poll_span{"RPCClient.poll"};
   if (IsHaltRequested())
   {
     return ExecutionStatus::FAILURE;
   }
-  if (m_future.wait_for(std::chrono::nanoseconds(0)) != std::future_status::ready)
+  auto wakeup_count = m_wakeup->GetCount();
+  if (m_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
   {
-    return ExecutionStatus::RUNNING;
+    // Wait (bounded by the timeout) for the reply instead of returning to be polled again
+    (void)m_wakeup->WaitForSignal(wakeup_count, m_finish);
+    if (IsHaltRequested())
+    {
+      return ExecutionStatus::FAILURE;
+    }
+    if (m_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      if (utils::GetNanosecsSinceEpoch() < m_finish)
+      {
+        return ExecutionStatus::RUNNING;
+      }
+      const std::string warning_message = InstructionWarningProlog(*this) +
+        "no reply received within timeout";
+      LogWarning(ui, warning_message);
+      return ExecutionStatus::FAILURE;
+    }
+  }
+  epics_helper::TraceInstant("RPCClient.reply");
+  sup::dto::AnyValue reply;
+  try
+  {
+    reply = m_future.get();
+  }
+  catch (const std::exception& e)
+  {
+    const std::string warning_message = InstructionWarningProlog(*this) +
+      "request failed with exception: " + e.what();
+    LogWarning(ui, warning_message);
+    return ExecutionStatus::FAILURE;
+  }
+  catch (...)
+  {
+    const std::string warning_message = InstructionWarningProlog(*this) +
+      "request failed with unknown exception";
+    LogWarning(ui, warning_message);
+    return ExecutionStatus::FAILURE;
   }
-  auto reply = m_future.get();
   if (HasAttribute(Constants::OUTPUT_VARIABLE_NAME_ATTRIBUTE_NAME))
   {
     if (!SetValueFromAttributeName(*this, ws, ui, Constants::OUTPUT_VARIABLE_NAME_ATTRIBUTE_NAME,
@@ -136,12 +200,15 @@ ExecutionStatus RPCClientInstruction::ExecuteSingleImpl(UserInterface& ui, Works
 void RPCClientInstruction::ResetHook(UserInterface& ui)
 {
   Halt(ui);
+  m_future = {};
+  m_finish = 0;
 }
 
 void RPCClientInstruction::HaltImpl(UserInterface& ui)
 {
   (void)ui;
-  m_future = {};
+  // The future is only released on reset: a concurrent ExecuteSingle may still be waiting for it
+  m_wakeup->Signal();
 }
 
 sup::dto::AnyValue RPCClientInstruction::GetRequest(UserInterface& ui, Workspace& ws)
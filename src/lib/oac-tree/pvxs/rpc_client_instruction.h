@@ -23,9 +23,12 @@
 #ifndef SUP_OAC_TREE_PLUGIN_EPICS_RPC_CLIENT_INSTRUCTION_H_
 #define SUP_OAC_TREE_PLUGIN_EPICS_RPC_CLIENT_INSTRUCTION_H_
 
+#include <oac-tree/common/wakeup_signal.h>
+
 #include <sup/oac-tree/instruction.h>
 
 #include <future>
+#include <memory>
 
 namespace sup
 {
@@ -41,7 +44,9 @@ namespace oac_tree
  * @details The instruction provides Remote Procedure Call (RPC) support to a named 'service',
  * sending a request from a named workspace 'request' variable or using 'type' and 'value'
  * attributes. The RPC call is made with a timeout that is given by the 'timeout' attribute or
- * the default value for the underlying RPC implementation.
+ * the default value for the underlying RPC implementation. The client reports an expired timeout
+ * in its reply, for which the instruction waits up to a second longer; it fails when no reply
+ * arrived by then or when the client threw an exception.
  * The reply is written back to the workspace if specified.
  *
  * @code
@@ -67,6 +72,8 @@ public:
 
 private:
   std::future<sup::dto::AnyValue> m_future;
+  std::shared_ptr<epics_helper::WakeupSignal> m_wakeup;  // Shared with the thread of the request
+  sup::dto::uint64 m_finish;
 
   bool InitHook(UserInterface& ui, Workspace& ws) override;
 
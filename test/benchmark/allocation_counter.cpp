@@ -0,0 +1,78 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<std::size_t> allocation_count{0};
+std::atomic<std::size_t> allocated_bytes{0};
+}  // unnamed namespace
+
+void* operator new(std::size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  void* result = std::malloc(size == 0 ? 1 : size);
+  if (result == nullptr)
+  {
+    throw std::bad_alloc{};
+  }
+  return result;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace sup {
+
+namespace oac_tree {
+
+namespace benchmark_utils {
+
+AllocationSnapshot GetAllocationSnapshot()
+{
+  return { allocation_count.load(std::memory_order_relaxed),
+           allocated_bytes.load(std::memory_order_relaxed) };
+}
+
+AllocationSnapshot operator-(const AllocationSnapshot& left, const AllocationSnapshot& right)
+{
+  return { left.allocations - right.allocations, left.bytes - right.bytes };
+}
+
+} // namespace benchmark_utils
+
+} // namespace oac_tree
+
+} // namespace sup
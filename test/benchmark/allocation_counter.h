@@ -0,0 +1,56 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_ALLOCATION_COUNTER_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+namespace sup {
+
+namespace oac_tree {
+
+namespace benchmark_utils {
+
+/**
+ * @brief Snapshot of the number of heap allocations and allocated bytes in this process.
+ *
+ * @details The counters are maintained by replacing the global operator new in the benchmark
+ * executable.
+ */
+struct AllocationSnapshot
+{
+  std::size_t allocations;
+  std::size_t bytes;
+};
+
+AllocationSnapshot GetAllocationSnapshot();
+
+AllocationSnapshot operator-(const AllocationSnapshot& left, const AllocationSnapshot& right);
+
+} // namespace benchmark_utils
+
+} // namespace oac_tree
+
+} // namespace sup
+
+#endif // SUP_OAC_TREE_PLUGIN_EPICS_ALLOCATION_COUNTER_H_
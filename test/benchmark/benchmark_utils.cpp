@@ -0,0 +1,159 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace
+{
+double Percentile(const std::vector<double>& sorted, double fraction);
+}  // unnamed namespace
+
+namespace sup {
+
+namespace oac_tree {
+
+namespace benchmark_utils {
+
+LatencyStatistics ComputeLatencyStatistics(std::vector<double> latencies)
+{
+  LatencyStatistics result{latencies.size(), 0.0, 0.0, 0.0, 0.0, 0.0};
+  if (latencies.empty())
+  {
+    return result;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  result.mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+                static_cast<double>(latencies.size());
+  result.p50 = Percentile(latencies, 0.5);
+  result.p99 = Percentile(latencies, 0.99);
+  result.p999 = Percentile(latencies, 0.999);
+  result.max = latencies.back();
+  return result;
+}
+
+void PrintLatencyHeader(const std::string& rate_name)
+{
+  std::printf("%-24s %10s %10s %10s %10s %10s %10s %12s\n", "Case", "samples", "mean[us]",
+              "p50[us]", "p99[us]", "p99.9[us]", "max[us]", rate_name.c_str());
+}
+
+void PrintLatencyStatistics(const std::string& label, const LatencyStatistics& stats,
+                            double rate)
+{
+  std::printf("%-24s %10zu %10.1f %10.1f %10.1f %10.1f %10.1f %12.0f\n", label.c_str(),
+              stats.count, stats.mean, stats.p50, stats.p99, stats.p999, stats.max, rate);
+  std::fflush(stdout);
+}
+
+void UseLocalEpicsAddressLists()
+{
+  // Existing settings are not overwritten
+  (void)setenv("EPICS_CA_AUTO_ADDR_LIST", "NO", 0);
+  (void)setenv("EPICS_CA_ADDR_LIST", "127.0.0.1", 0);
+  (void)setenv("EPICS_PVA_AUTO_ADDR_LIST", "NO", 0);
+  (void)setenv("EPICS_PVA_ADDR_LIST", "127.0.0.1", 0);
+}
+
+std::size_t GetResidentMemory()
+{
+  std::ifstream statm{"/proc/self/statm"};
+  std::size_t total_pages = 0;
+  std::size_t resident_pages = 0;
+  if (!(statm >> total_pages >> resident_pages))
+  {
+    return 0;
+  }
+  return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+double GetProcessCpuSeconds()
+{
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0.0;
+  }
+  auto to_seconds = [](const timeval& tv) {
+    return static_cast<double>(tv.tv_sec) + 1e-6 * static_cast<double>(tv.tv_usec);
+  };
+  return to_seconds(usage.ru_utime) + to_seconds(usage.ru_stime);
+}
+
+std::string CreateProcedureString(const std::string& body)
+{
+  static const std::string header{
+      R"RAW(<?xml version="1.0" encoding="UTF-8"?>
+<Procedure xmlns="http://codac.iter.org/sup/oac-tree" version="1.0"
+           name="Benchmark procedure"
+           xmlns:xs="http://www.w3.org/2001/XMLSchema-instance"
+           xs:schemaLocation="http://codac.iter.org/sup/oac-tree oac-tree.xsd">)RAW"};
+
+  static const std::string footer{R"RAW(</Procedure>)RAW"};
+
+  return header + body + footer;
+}
+
+ExecutionStatus RunProcedure(Procedure& proc, UserInterface& ui,
+                             std::chrono::nanoseconds timeout)
+{
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  bool halted = false;
+  proc.Setup();
+  ExecutionStatus status = ExecutionStatus::NOT_STARTED;
+  do
+  {
+    proc.ExecuteSingle(ui);
+    status = proc.GetStatus();
+    if (!halted && std::chrono::steady_clock::now() > deadline)
+    {
+      proc.Halt();
+      halted = true;
+    }
+  } while (status != ExecutionStatus::SUCCESS && status != ExecutionStatus::FAILURE);
+  proc.Reset(ui);
+  return status;
+}
+
+} // namespace benchmark_utils
+
+} // namespace oac_tree
+
+} // namespace sup
+
+namespace
+{
+double Percentile(const std::vector<double>& sorted, double fraction)
+{
+  auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+  return sorted[std::min(std::max(rank, std::size_t{1}), sorted.size()) - 1];
+}
+}  // unnamed namespace
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_PLUGIN_EPICS_BENCHMARK_UTILS_H_
+#define SUP_OAC_TREE_PLUGIN_EPICS_BENCHMARK_UTILS_H_
+
+#include <sup/oac-tree/execution_status.h>
+#include <sup/oac-tree/procedure.h>
+#include <sup/oac-tree/user_interface.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace sup {
+
+namespace oac_tree {
+
+namespace benchmark_utils {
+
+/**
+ * @brief Summary of a series of latency measurements, in microseconds.
+ */
+struct LatencyStatistics
+{
+  std::size_t count;
+  double mean;
+  double p50;
+  double p99;
+  double p999;
+  double max;
+};
+
+/**
+ * @brief Compute the latency summary of the given measurements (in microseconds).
+ */
+LatencyStatistics ComputeLatencyStatistics(std::vector<double> latencies);
+
+/**
+ * @brief Print a latency summary as a single table row, preceded by its label.
+ */
+void PrintLatencyStatistics(const std::string& label, const LatencyStatistics& stats,
+                            double rate);
+
+/**
+ * @brief Print the header of the table produced by PrintLatencyStatistics, using the given name
+ * for the rate column (e.g. "updates/s").
+ */
+void PrintLatencyHeader(const std::string& rate_name);
+
+/**
+ * @brief Restrict Channel Access and pvAccess name resolution to the local host, unless the user
+ * already configured the address lists. This allows running the benchmarks on an offline machine.
+ */
+void UseLocalEpicsAddressLists();
+
+/**
+ * @brief Resident set size of the current process in bytes, or zero if it cannot be determined.
+ */
+std::size_t GetResidentMemory();
+
+/**
+ * @brief User and system CPU time consumed by all threads of the current process, in seconds.
+ */
+double GetProcessCpuSeconds();
+
+/**
+ * @brief Wrap a procedure body in the procedure XML element.
+ */
+std::string CreateProcedureString(const std::string& body);
+
+/**
+ * @brief Setup and execute a procedure until it finishes, halting it when the timeout expires.
+ *
+ * @return Final execution status.
+ */
+ExecutionStatus RunProcedure(Procedure& proc, UserInterface& ui,
+                             std::chrono::nanoseconds timeout);
+
+} // namespace benchmark_utils
+
+} // namespace oac_tree
+
+} // namespace sup
+
+#endif // SUP_OAC_TREE_PLUGIN_EPICS_BENCHMARK_UTILS_H_
@@ -0,0 +1,256 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <oac-tree/ca/channel_access_helper.h>
+#include <oac-tree/pvxs/pv_access_helper.h>
+
+#include <sup/dto/anyvalue_helper.h>
+#include <sup/protocol/base64_variable_codec.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace sup::oac_tree;
+
+namespace
+{
+const std::string SAMPLES_FIELD = "samples";
+
+// Array of float64 with the payload size (number of elements) of the benchmark.
+sup::dto::AnyType PayloadType(const benchmark::State& state);
+
+// Declared type of a CA variable with all metadata fields.
+sup::dto::AnyType CAMetadataType(const sup::dto::AnyType& value_type);
+
+sup::epics::ChannelAccessPV::ExtendedValue CreateCAUpdate(const sup::dto::AnyType& value_type);
+
+// Structure as typically published by a PVA server: value, alarm and timestamp.
+sup::dto::AnyValue CreatePVAStructure(const sup::dto::AnyType& value_type);
+
+// Structure of a record as exchanged through encoded PVA variables.
+sup::dto::AnyValue CreateRecord(const sup::dto::AnyType& samples_type);
+
+void SetPayloadBytes(benchmark::State& state);
+
+// Payload sizes used by all parameterized benchmarks.
+void PayloadSizes(benchmark::internal::Benchmark* bench);
+}  // unnamed namespace
+
+// CA update without metadata: the received value already has the declared type.
+static void BM_CAConvertPlain(benchmark::State& state)
+{
+  auto value_type = PayloadType(state);
+  auto update = CreateCAUpdate(value_type);
+  for (auto _ : state)
+  {
+    auto value = channel_access_helper::ConvertToTypedAnyValue(update, value_type);
+    benchmark::DoNotOptimize(value);
+  }
+  SetPayloadBytes(state);
+}
+BENCHMARK(BM_CAConvertPlain)->Apply(PayloadSizes);
+
+// CA update into a structure with 'connected', 'timestamp', 'status' and 'severity' fields.
+static void BM_CAConvertWithMetadata(benchmark::State& state)
+{
+  auto value_type = PayloadType(state);
+  auto anytype = CAMetadataType(value_type);
+  auto update = CreateCAUpdate(value_type);
+  for (auto _ : state)
+  {
+    auto value = channel_access_helper::ConvertToTypedAnyValue(update, anytype);
+    benchmark::DoNotOptimize(value);
+  }
+  SetPayloadBytes(state);
+}
+BENCHMARK(BM_CAConvertWithMetadata)->Apply(PayloadSizes);
+
+// PVA update of a scalar variable: the 'value' field is extracted and converted.
+static void BM_PVAConvertScalar(benchmark::State& state)
+{
+  sup::dto::AnyValue update = {{
+    { pv_access_helper::VALUE_FIELD_NAME, {sup::dto::SignedInteger32Type, 1729 }}
+  }};
+  for (auto _ : state)
+  {
+    auto value = pv_access_helper::ConvertToTypedAnyValue(update, sup::dto::Float64Type);
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(BM_PVAConvertScalar);
+
+// PVA update of a structured variable that declares the complete structure.
+static void BM_PVAConvertFullStruct(benchmark::State& state)
+{
+  auto update = CreatePVAStructure(PayloadType(state));
+  auto anytype = update.GetType();
+  for (auto _ : state)
+  {
+    auto value = pv_access_helper::ConvertToTypedAnyValue(update, anytype);
+    benchmark::DoNotOptimize(value);
+  }
+  SetPayloadBytes(state);
+}
+BENCHMARK(BM_PVAConvertFullStruct)->Apply(PayloadSizes);
+
+// PVA update of a structured variable that only declares the 'value' field.
+static void BM_PVAConvertPartialStruct(benchmark::State& state)
+{
+  auto value_type = PayloadType(state);
+  auto update = CreatePVAStructure(value_type);
+  sup::dto::AnyType anytype = {{
+    { pv_access_helper::VALUE_FIELD_NAME, value_type }
+  }};
+  for (auto _ : state)
+  {
+    auto value = pv_access_helper::ConvertToTypedAnyValue(update, anytype);
+    benchmark::DoNotOptimize(value);
+  }
+  SetPayloadBytes(state);
+}
+BENCHMARK(BM_PVAConvertPartialStruct)->Apply(PayloadSizes);
+
+static void BM_PackIntoStructIfScalar(benchmark::State& state)
+{
+  sup::dto::AnyValue scalar{sup::dto::Float64Type, 3.14};
+  for (auto _ : state)
+  {
+    auto packed = pv_access_helper::PackIntoStructIfScalar(scalar);
+    benchmark::DoNotOptimize(packed);
+  }
+}
+BENCHMARK(BM_PackIntoStructIfScalar);
+
+// Non-scalar values are passed as is, which still implies a copy for the const overload.
+static void BM_PackIntoStructIfScalarArray(benchmark::State& state)
+{
+  sup::dto::AnyValue array{PayloadType(state)};
+  for (auto _ : state)
+  {
+    auto packed = pv_access_helper::PackIntoStructIfScalar(array);
+    benchmark::DoNotOptimize(packed);
+  }
+  SetPayloadBytes(state);
+}
+BENCHMARK(BM_PackIntoStructIfScalarArray)->Apply(PayloadSizes);
+
+static void BM_Base64Encode(benchmark::State& state)
+{
+  auto record = CreateRecord(PayloadType(state));
+  for (auto _ : state)
+  {
+    auto encoded = sup::protocol::Base64VariableCodec::Encode(record);
+    benchmark::DoNotOptimize(encoded);
+  }
+  SetPayloadBytes(state);
+}
+BENCHMARK(BM_Base64Encode)->Apply(PayloadSizes);
+
+static void BM_Base64Decode(benchmark::State& state)
+{
+  auto encoded = sup::protocol::Base64VariableCodec::Encode(CreateRecord(PayloadType(state)));
+  if (!encoded.first)
+  {
+    state.SkipWithError("Encoding failed");
+    return;
+  }
+  for (auto _ : state)
+  {
+    auto decoded = sup::protocol::Base64VariableCodec::Decode(encoded.second);
+    benchmark::DoNotOptimize(decoded);
+  }
+  SetPayloadBytes(state);
+}
+BENCHMARK(BM_Base64Decode)->Apply(PayloadSizes);
+
+namespace
+{
+sup::dto::AnyType PayloadType(const benchmark::State& state)
+{
+  auto n_elements = static_cast<std::size_t>(state.range(0));
+  return sup::dto::AnyType{n_elements, sup::dto::Float64Type, "float64[]"};
+}
+
+sup::dto::AnyType CAMetadataType(const sup::dto::AnyType& value_type)
+{
+  sup::dto::AnyType result = {{
+    { channel_access_helper::VALUE_FIELD_NAME, value_type },
+    { channel_access_helper::CONNECTED_FIELD_NAME, sup::dto::BooleanType },
+    { channel_access_helper::TIMESTAMP_FIELD_NAME, sup::dto::UnsignedInteger64Type },
+    { channel_access_helper::STATUS_FIELD_NAME, sup::dto::SignedInteger16Type },
+    { channel_access_helper::SEVERITY_FIELD_NAME, sup::dto::SignedInteger16Type }
+  }};
+  return result;
+}
+
+sup::epics::ChannelAccessPV::ExtendedValue CreateCAUpdate(const sup::dto::AnyType& value_type)
+{
+  sup::epics::ChannelAccessPV::ExtendedValue result;
+  result.connected = true;
+  result.value = sup::dto::AnyValue{value_type};
+  result.timestamp = 1700000000000000000U;
+  result.status = 0;
+  result.severity = 0;
+  return result;
+}
+
+sup::dto::AnyValue CreatePVAStructure(const sup::dto::AnyType& value_type)
+{
+  sup::dto::AnyValue alarm = {{
+    { "severity", {sup::dto::SignedInteger32Type, 0 }},
+    { "status", {sup::dto::SignedInteger32Type, 0 }},
+    { "message", {sup::dto::StringType, "" }}
+  }, "alarm_t"};
+  sup::dto::AnyValue time_stamp = {{
+    { "secondsPastEpoch", {sup::dto::SignedInteger64Type, 1700000000 }},
+    { "nanoseconds", {sup::dto::SignedInteger32Type, 0 }},
+    { "userTag", {sup::dto::SignedInteger32Type, 0 }}
+  }, "time_t"};
+  sup::dto::AnyValue result = {{
+    { pv_access_helper::VALUE_FIELD_NAME, sup::dto::AnyValue{value_type} },
+    { "alarm", alarm },
+    { "timeStamp", time_stamp }
+  }, "epics:nt/NTScalarArray:1.0"};
+  return result;
+}
+
+sup::dto::AnyValue CreateRecord(const sup::dto::AnyType& samples_type)
+{
+  sup::dto::AnyValue result = {{
+    { "name", {sup::dto::StringType, "PLANT:SYSTEM:DIAGNOSTIC" }},
+    { "timestamp", {sup::dto::UnsignedInteger64Type, 1700000000000000000U }},
+    { "valid", {sup::dto::BooleanType, true }},
+    { SAMPLES_FIELD, sup::dto::AnyValue{samples_type} }
+  }, "oac-tree::benchmark::Record/v1.0"};
+  return result;
+}
+
+void SetPayloadBytes(benchmark::State& state)
+{
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          static_cast<std::int64_t>(sizeof(sup::dto::float64)));
+}
+
+void PayloadSizes(benchmark::internal::Benchmark* bench)
+{
+  bench->RangeMultiplier(16)->Range(1, 1 << 16);
+}
+}  // unnamed namespace
@@ -0,0 +1,516 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include <sup/oac-tree/variable.h>
+#include <sup/oac-tree/variable_registry.h>
+#include <sup/oac-tree/workspace.h>
+
+#include <sup/dto/json_type_parser.h>
+#include <sup/epics/pv_access_client_pv.h>
+#include <sup/protocol/base64_variable_codec.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace sup::oac_tree;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+const std::chrono::milliseconds DRAIN_TIME{500};
+const double CONNECT_TIMEOUT = 5.0;
+
+const std::string TIMESTAMP_FIELD = "timestamp";
+const std::string VALUE_FIELD = "value";
+
+const std::string SCALAR_TYPE = R"RAW({"type":"uint64"})RAW";
+const std::string STRUCTURED_TYPE = R"RAW(
+{
+  "type":"fanout_payload_t",
+  "attributes":[
+    {"timestamp":{"type":"uint64"}},
+    {"status":{"type":"string"}},
+    {"data":{"type":"float64[]","multiplicity":16,"element":{"type":"float64"}}}
+  ]
+})RAW";
+
+enum class PayloadKind
+{
+  SCALAR = 0,
+  STRUCTURED,
+  ENCODED
+};
+
+struct Options
+{
+  std::size_t n_channels;
+  std::size_t n_subscribers;
+  std::vector<double> rates;
+  double duration;
+  std::vector<PayloadKind> kinds;
+};
+
+struct FanOutResult
+{
+  std::size_t posts;
+  double posts_per_second;
+  double updates_per_second;
+  double delivered_fraction;
+  benchmark_utils::LatencyStatistics lag;
+  double cpu_per_post;
+};
+
+/**
+ * @brief Monitor of one published channel that records the lag between posting and reception of
+ * each update. Posted values carry the steady clock time at which they were set.
+ */
+class Subscriber
+{
+public:
+  Subscriber(const std::string& channel, PayloadKind kind);
+  ~Subscriber();
+
+  bool WaitForConnected(double timeout_sec) const;
+
+  void StartRecording(std::uint64_t start_ns);
+
+  std::vector<double> StopRecording();
+
+private:
+  void HandleUpdate(const sup::epics::PvAccessClientPV::ExtendedValue& ext_value);
+  PayloadKind m_kind;
+  std::mutex m_mtx;
+  bool m_recording;
+  std::uint64_t m_start_ns;
+  std::vector<double> m_lags;
+  std::unique_ptr<sup::epics::PvAccessClientPV> m_pv;  // Destroyed first: stops the callbacks
+};
+
+bool ParseOptions(int argc, char* argv[], Options& options);
+
+bool ParseRates(const std::string& rates_str, std::vector<double>& rates);
+
+std::string KindName(PayloadKind kind);
+
+std::string ChannelName(PayloadKind kind, std::size_t idx);
+
+std::string VariableName(std::size_t idx);
+
+std::uint64_t NowNanoseconds();
+
+// Value that is posted, with the timestamp to be filled in for every post.
+sup::dto::AnyValue CreatePayload(PayloadKind kind);
+
+void SetTimestamp(PayloadKind kind, sup::dto::AnyValue& payload, std::uint64_t timestamp);
+
+// Returns zero if the timestamp could not be extracted.
+std::uint64_t ExtractTimestamp(PayloadKind kind, const sup::dto::AnyValue& value);
+
+std::unique_ptr<Workspace> CreateServerWorkspace(PayloadKind kind, std::size_t n_channels);
+
+FanOutResult RunFanOut(Workspace& ws, std::vector<std::unique_ptr<Subscriber>>& subscribers,
+                       PayloadKind kind, std::size_t n_channels, double rate, double duration);
+
+bool RunPayloadKind(PayloadKind kind, const Options& options);
+
+void PrintFanOutHeader();
+
+void PrintFanOutResult(PayloadKind kind, double rate, const FanOutResult& result);
+}  // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+  Options options{10, 4, {1000.0, 10000.0, 100000.0, 0.0}, 2.0,
+                  {PayloadKind::SCALAR, PayloadKind::STRUCTURED, PayloadKind::ENCODED}};
+  if (!ParseOptions(argc, argv, options))
+  {
+    std::cerr << "Usage: " << argv[0] << " [--channels K] [--subscribers M] "
+              << "[--rates R[,R...]|max] [--duration SECONDS] "
+              << "[--payload scalar|struct|encoded|all]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  benchmark_utils::UseLocalEpicsAddressLists();
+  std::printf("%zu channels, %zu subscribers per channel\n", options.n_channels,
+              options.n_subscribers);
+  PrintFanOutHeader();
+  bool success = true;
+  for (auto kind : options.kinds)
+  {
+    success = RunPayloadKind(kind, options) && success;
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+namespace
+{
+Subscriber::Subscriber(const std::string& channel, PayloadKind kind)
+  : m_kind{kind}
+  , m_mtx{}
+  , m_recording{false}
+  , m_start_ns{0}
+  , m_lags{}
+  , m_pv{}
+{
+  auto callback = [this](const sup::epics::PvAccessClientPV::ExtendedValue& ext_value) {
+    HandleUpdate(ext_value);
+  };
+  m_pv = std::make_unique<sup::epics::PvAccessClientPV>(channel, callback);
+}
+
+Subscriber::~Subscriber() = default;
+
+bool Subscriber::WaitForConnected(double timeout_sec) const
+{
+  return m_pv->WaitForConnected(timeout_sec);
+}
+
+void Subscriber::StartRecording(std::uint64_t start_ns)
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  m_lags.clear();
+  m_start_ns = start_ns;
+  m_recording = true;
+}
+
+std::vector<double> Subscriber::StopRecording()
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  m_recording = false;
+  return std::move(m_lags);
+}
+
+void Subscriber::HandleUpdate(const sup::epics::PvAccessClientPV::ExtendedValue& ext_value)
+{
+  auto received_ns = NowNanoseconds();
+  if (!ext_value.connected)
+  {
+    return;
+  }
+  auto posted_ns = ExtractTimestamp(m_kind, ext_value.value);
+  std::lock_guard<std::mutex> lk{m_mtx};
+  // Ignore initial values and updates posted before the start of the current run
+  if (!m_recording || posted_ns < m_start_ns || posted_ns > received_ns)
+  {
+    return;
+  }
+  m_lags.push_back(1e-3 * static_cast<double>(received_ns - posted_ns));
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+  for (int idx = 1; idx < argc; ++idx)
+  {
+    if (idx + 1 >= argc)
+    {
+      return false;
+    }
+    std::string option{argv[idx]};
+    std::string value{argv[++idx]};
+    if (option == "--channels")
+    {
+      options.n_channels = std::strtoul(value.c_str(), nullptr, 10);
+      if (options.n_channels == 0)
+      {
+        return false;
+      }
+    }
+    else if (option == "--subscribers")
+    {
+      options.n_subscribers = std::strtoul(value.c_str(), nullptr, 10);
+      if (options.n_subscribers == 0)
+      {
+        return false;
+      }
+    }
+    else if (option == "--rates")
+    {
+      if (!ParseRates(value, options.rates))
+      {
+        return false;
+      }
+    }
+    else if (option == "--duration")
+    {
+      options.duration = std::strtod(value.c_str(), nullptr);
+      if (options.duration <= 0.0)
+      {
+        return false;
+      }
+    }
+    else if (option == "--payload")
+    {
+      if (value == "scalar")
+      {
+        options.kinds = {PayloadKind::SCALAR};
+      }
+      else if (value == "struct")
+      {
+        options.kinds = {PayloadKind::STRUCTURED};
+      }
+      else if (value == "encoded")
+      {
+        options.kinds = {PayloadKind::ENCODED};
+      }
+      else if (value != "all")
+      {
+        return false;
+      }
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParseRates(const std::string& rates_str, std::vector<double>& rates)
+{
+  std::vector<double> result;
+  std::istringstream iss{rates_str};
+  std::string rate_str;
+  while (std::getline(iss, rate_str, ','))
+  {
+    // A rate of zero means posting as fast as possible
+    auto rate = rate_str == "max" ? 0.0 : std::strtod(rate_str.c_str(), nullptr);
+    if (rate < 0.0 || (rate == 0.0 && rate_str != "max"))
+    {
+      return false;
+    }
+    result.push_back(rate);
+  }
+  if (result.empty())
+  {
+    return false;
+  }
+  rates = std::move(result);
+  return true;
+}
+
+std::string KindName(PayloadKind kind)
+{
+  switch (kind)
+  {
+  case PayloadKind::SCALAR:
+    return "scalar";
+  case PayloadKind::STRUCTURED:
+    return "struct";
+  case PayloadKind::ENCODED:
+    return "encoded";
+  }
+  return "unknown";
+}
+
+std::string ChannelName(PayloadKind kind, std::size_t idx)
+{
+  return "fanout-test::" + KindName(kind) + "-" + std::to_string(idx);
+}
+
+std::string VariableName(std::size_t idx)
+{
+  return "var" + std::to_string(idx);
+}
+
+std::uint64_t NowNanoseconds()
+{
+  auto since_epoch = Clock::now().time_since_epoch();
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count());
+}
+
+sup::dto::AnyValue CreatePayload(PayloadKind kind)
+{
+  if (kind == PayloadKind::SCALAR)
+  {
+    return sup::dto::AnyValue{sup::dto::UnsignedInteger64Type};
+  }
+  sup::dto::JSONAnyTypeParser parser;
+  if (!parser.ParseString(STRUCTURED_TYPE))
+  {
+    return {};
+  }
+  sup::dto::AnyValue payload{parser.MoveAnyType()};
+  payload["status"] = "running";
+  return payload;
+}
+
+void SetTimestamp(PayloadKind kind, sup::dto::AnyValue& payload, std::uint64_t timestamp)
+{
+  if (kind == PayloadKind::SCALAR)
+  {
+    payload = sup::dto::uint64{timestamp};
+    return;
+  }
+  payload[TIMESTAMP_FIELD] = sup::dto::uint64{timestamp};
+}
+
+std::uint64_t ExtractTimestamp(PayloadKind kind, const sup::dto::AnyValue& value)
+{
+  switch (kind)
+  {
+  case PayloadKind::SCALAR:
+    // Scalars are published inside a structure with a single value field
+    return value.HasField(VALUE_FIELD) ? value[VALUE_FIELD].As<sup::dto::uint64>() : 0;
+  case PayloadKind::STRUCTURED:
+    return value.HasField(TIMESTAMP_FIELD) ? value[TIMESTAMP_FIELD].As<sup::dto::uint64>() : 0;
+  case PayloadKind::ENCODED:
+  {
+    auto decoded = sup::protocol::Base64VariableCodec::Decode(value);
+    return decoded.first && decoded.second.HasField(TIMESTAMP_FIELD)
+      ? decoded.second[TIMESTAMP_FIELD].As<sup::dto::uint64>()
+      : 0;
+  }
+  }
+  return 0;
+}
+
+std::unique_ptr<Workspace> CreateServerWorkspace(PayloadKind kind, std::size_t n_channels)
+{
+  auto var_type = kind == PayloadKind::ENCODED ? "PvAccessEncodedServer" : "PvAccessServer";
+  auto type_str = kind == PayloadKind::SCALAR ? SCALAR_TYPE : STRUCTURED_TYPE;
+  auto workspace = std::make_unique<Workspace>();
+  for (std::size_t idx = 0; idx < n_channels; ++idx)
+  {
+    auto variable = GlobalVariableRegistry().Create(var_type);
+    (void)variable->AddAttribute("channel", ChannelName(kind, idx));
+    (void)variable->AddAttribute("type", type_str);
+    (void)workspace->AddVariable(VariableName(idx), std::move(variable));
+  }
+  return workspace;
+}
+
+FanOutResult RunFanOut(Workspace& ws, std::vector<std::unique_ptr<Subscriber>>& subscribers,
+                       PayloadKind kind, std::size_t n_channels, double rate, double duration)
+{
+  FanOutResult result{};
+  auto payload = CreatePayload(kind);
+  std::vector<std::string> var_names;
+  for (std::size_t idx = 0; idx < n_channels; ++idx)
+  {
+    var_names.push_back(VariableName(idx));
+  }
+  for (auto& subscriber : subscribers)
+  {
+    subscriber->StartRecording(NowNanoseconds());
+  }
+  auto cpu_before = benchmark_utils::GetProcessCpuSeconds();
+  auto start = Clock::now();
+  auto end = start + std::chrono::duration_cast<Clock::duration>(
+                       std::chrono::duration<double>(duration));
+  for (auto now = start; now < end; now = Clock::now())
+  {
+    if (rate > 0.0)
+    {
+      std::chrono::duration<double> offset{static_cast<double>(result.posts) / rate};
+      auto next = start + std::chrono::duration_cast<Clock::duration>(offset);
+      if (next > now)
+      {
+        std::this_thread::sleep_until(next);
+        continue;
+      }
+    }
+    SetTimestamp(kind, payload, NowNanoseconds());
+    (void)ws.SetValue(var_names[result.posts % n_channels], payload);
+    ++result.posts;
+  }
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  // Let the subscribers catch up: their lag is part of the measurement
+  std::this_thread::sleep_for(DRAIN_TIME);
+  auto cpu_seconds = benchmark_utils::GetProcessCpuSeconds() - cpu_before;
+
+  std::vector<double> lags;
+  for (auto& subscriber : subscribers)
+  {
+    auto subscriber_lags = subscriber->StopRecording();
+    lags.insert(lags.end(), subscriber_lags.begin(), subscriber_lags.end());
+  }
+  auto expected_updates =
+    static_cast<double>(result.posts) * static_cast<double>(subscribers.size() / n_channels);
+  result.posts_per_second = static_cast<double>(result.posts) / elapsed.count();
+  result.updates_per_second = static_cast<double>(lags.size()) / elapsed.count();
+  result.delivered_fraction =
+    expected_updates > 0.0 ? static_cast<double>(lags.size()) / expected_updates : 0.0;
+  result.lag = benchmark_utils::ComputeLatencyStatistics(std::move(lags));
+  // Subscribers run in the same process, so their share of the work is included
+  result.cpu_per_post =
+    result.posts > 0 ? 1e6 * cpu_seconds / static_cast<double>(result.posts) : 0.0;
+  return result;
+}
+
+bool RunPayloadKind(PayloadKind kind, const Options& options)
+{
+  auto workspace = CreateServerWorkspace(kind, options.n_channels);
+  workspace->Setup();
+  std::vector<std::unique_ptr<Subscriber>> subscribers;
+  for (std::size_t idx = 0; idx < options.n_channels; ++idx)
+  {
+    for (std::size_t sub_idx = 0; sub_idx < options.n_subscribers; ++sub_idx)
+    {
+      subscribers.push_back(std::make_unique<Subscriber>(ChannelName(kind, idx), kind));
+    }
+  }
+  for (const auto& subscriber : subscribers)
+  {
+    if (!subscriber->WaitForConnected(CONNECT_TIMEOUT))
+    {
+      std::cerr << KindName(kind) << ": subscribers could not connect" << std::endl;
+      subscribers.clear();
+      workspace->Teardown();
+      return false;
+    }
+  }
+  for (auto rate : options.rates)
+  {
+    auto result =
+      RunFanOut(*workspace, subscribers, kind, options.n_channels, rate, options.duration);
+    PrintFanOutResult(kind, rate, result);
+  }
+  subscribers.clear();
+  workspace->Teardown();
+  return true;
+}
+
+void PrintFanOutHeader()
+{
+  std::printf("%-8s %10s %10s %11s %9s %10s %10s %10s %10s %12s\n", "Payload", "rate", "posts/s",
+              "updates/s", "received", "p50[us]", "p99[us]", "p99.9[us]", "max[us]",
+              "CPU[us]/post");
+}
+
+void PrintFanOutResult(PayloadKind kind, double rate, const FanOutResult& result)
+{
+  auto rate_str = rate > 0.0 ? std::to_string(static_cast<std::size_t>(rate)) : "max";
+  std::printf("%-8s %10s %10.0f %11.0f %8.1f%% %10.1f %10.1f %10.1f %10.1f %12.2f\n",
+              KindName(kind).c_str(), rate_str.c_str(), result.posts_per_second,
+              result.updates_per_second, 100.0 * result.delivered_fraction, result.lag.p50,
+              result.lag.p99, result.lag.p999, result.lag.max, result.cpu_per_post);
+  std::fflush(stdout);
+}
+}  // unnamed namespace
@@ -0,0 +1,261 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "allocation_counter.h"
+
+#include <oac-tree/ca/channel_access_helper.h>
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/pvxs/pv_access_helper.h>
+#include <oac-tree/pvxs/pv_access_server_variable.h>
+
+#include <sup/oac-tree/workspace.h>
+
+#include <sup/dto/anyvalue_helper.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+using namespace sup::oac_tree;
+
+namespace
+{
+const std::string VALUE_FIELD = "value";
+const std::string SERVER_VARIABLE = "server";
+
+sup::dto::AnyType Float64ArrayType(const benchmark::State& state);
+
+// Set up a workspace with a PvAccessServer variable of the float64 array type of the benchmark.
+void SetupServerWorkspace(Workspace& ws, const benchmark::State& state, const std::string& name);
+
+// Number of bytes allocated when copying the given value once.
+std::size_t BytesPerCopy(const sup::dto::AnyValue& value);
+
+// Report the number of full copies of the payload per iteration.
+void SetCopyCounters(benchmark::State& state, const benchmark_utils::AllocationSnapshot& before,
+                     std::size_t bytes_per_copy);
+}  // unnamed namespace
+
+// Reading a ChannelAccessClient variable, as before the move-aware overloads.
+static void BM_CAGetValueCopy(benchmark::State& state)
+{
+  auto array_type = Float64ArrayType(state);
+  sup::epics::ChannelAccessPV::ExtendedValue cached;
+  cached.connected = true;
+  cached.value = sup::dto::AnyValue{array_type};
+  auto bytes_per_copy = BytesPerCopy(cached.value);
+  auto before = benchmark_utils::GetAllocationSnapshot();
+  for (auto _ : state)
+  {
+    auto ext_value = cached;  // ChannelAccessPV::GetExtendedValue()
+    auto result = channel_access_helper::ConvertToTypedAnyValue(ext_value, array_type);
+    sup::dto::AnyValue output;
+    sup::dto::TryAssign(output, result);
+    benchmark::DoNotOptimize(output);
+  }
+  SetCopyCounters(state, before, bytes_per_copy);
+}
+BENCHMARK(BM_CAGetValueCopy)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+// Reading a ChannelAccessClient variable, moving the obtained value through the conversion.
+static void BM_CAGetValueMove(benchmark::State& state)
+{
+  auto array_type = Float64ArrayType(state);
+  sup::epics::ChannelAccessPV::ExtendedValue cached;
+  cached.connected = true;
+  cached.value = sup::dto::AnyValue{array_type};
+  auto bytes_per_copy = BytesPerCopy(cached.value);
+  auto before = benchmark_utils::GetAllocationSnapshot();
+  for (auto _ : state)
+  {
+    auto ext_value = cached;  // ChannelAccessPV::GetExtendedValue()
+    auto result = channel_access_helper::ConvertToTypedAnyValue(std::move(ext_value), array_type);
+    sup::dto::AnyValue output;
+    epics_helper::MoveOrAssign(output, std::move(result));
+    benchmark::DoNotOptimize(output);
+  }
+  SetCopyCounters(state, before, bytes_per_copy);
+}
+BENCHMARK(BM_CAGetValueMove)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+// Copying the second half of a received array element by element, as before the bulk copy.
+static void BM_CACopyElementRangePerElement(benchmark::State& state)
+{
+  auto array_type = Float64ArrayType(state);
+  sup::dto::AnyValue full_value{array_type};
+  channel_access_helper::ElementRange range{array_type.NumberOfElements() / 2,
+                                            array_type.NumberOfElements() / 2};
+  sup::dto::AnyValue range_value{
+    sup::dto::AnyType{range.count, sup::dto::Float64Type, "float64[]"}};
+  for (auto _ : state)
+  {
+    for (sup::dto::uint64 idx = 0; idx < range.count; ++idx)
+    {
+      range_value[idx] = full_value[range.offset + idx];
+    }
+    benchmark::DoNotOptimize(range_value);
+  }
+}
+BENCHMARK(BM_CACopyElementRangePerElement)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+// Copying the second half of a received array with channel_access_helper::CopyElementRange.
+static void BM_CACopyElementRangeBulk(benchmark::State& state)
+{
+  auto array_type = Float64ArrayType(state);
+  sup::dto::AnyValue full_value{array_type};
+  channel_access_helper::ElementRange range{array_type.NumberOfElements() / 2,
+                                            array_type.NumberOfElements() / 2};
+  sup::dto::AnyValue range_value{
+    sup::dto::AnyType{range.count, sup::dto::Float64Type, "float64[]"}};
+  for (auto _ : state)
+  {
+    if (!channel_access_helper::CopyElementRange(range_value, full_value, range))
+    {
+      state.SkipWithError("range copy failed");
+      break;
+    }
+    benchmark::DoNotOptimize(range_value);
+  }
+}
+BENCHMARK(BM_CACopyElementRangeBulk)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+// Reading a PvAccessClient/PvAccessServer variable, as before the move-aware overloads.
+static void BM_PVAGetValueCopy(benchmark::State& state)
+{
+  auto array_type = Float64ArrayType(state);
+  sup::dto::AnyValue cached{array_type};
+  auto bytes_per_copy = BytesPerCopy(cached);
+  auto before = benchmark_utils::GetAllocationSnapshot();
+  for (auto _ : state)
+  {
+    auto pv_value = cached;  // PvAccessClientPV::GetValue()
+    auto result = pv_access_helper::ConvertToTypedAnyValue(pv_value, array_type);
+    sup::dto::AnyValue output;
+    sup::dto::TryAssign(output, result);
+    benchmark::DoNotOptimize(output);
+  }
+  SetCopyCounters(state, before, bytes_per_copy);
+}
+BENCHMARK(BM_PVAGetValueCopy)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+// Reading a PvAccessClient/PvAccessServer variable, moving the obtained value.
+static void BM_PVAGetValueMove(benchmark::State& state)
+{
+  auto array_type = Float64ArrayType(state);
+  sup::dto::AnyValue cached{array_type};
+  auto bytes_per_copy = BytesPerCopy(cached);
+  auto before = benchmark_utils::GetAllocationSnapshot();
+  for (auto _ : state)
+  {
+    auto pv_value = cached;  // PvAccessClientPV::GetValue()
+    auto result = pv_access_helper::ConvertToTypedAnyValue(std::move(pv_value), array_type);
+    sup::dto::AnyValue output;
+    epics_helper::MoveOrAssign(output, std::move(result));
+    benchmark::DoNotOptimize(output);
+  }
+  SetCopyCounters(state, before, bytes_per_copy);
+}
+BENCHMARK(BM_PVAGetValueMove)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+// Setting a PvAccessServer variable, copying the value first as before the fast path for
+// matching types.
+static void BM_PVAServerSetValueCopy(benchmark::State& state)
+{
+  auto array_type = Float64ArrayType(state);
+  Workspace ws;
+  SetupServerWorkspace(ws, state, "copy");
+  sup::dto::AnyValue value{array_type};
+  auto bytes_per_copy = BytesPerCopy(value);
+  auto before = benchmark_utils::GetAllocationSnapshot();
+  for (auto _ : state)
+  {
+    sup::dto::AnyValue copy(array_type);
+    sup::dto::TryConvert(copy, value);
+    bool result = ws.SetValue(SERVER_VARIABLE, copy);
+    benchmark::DoNotOptimize(result);
+  }
+  SetCopyCounters(state, before, bytes_per_copy);
+  ws.Teardown();
+}
+BENCHMARK(BM_PVAServerSetValueCopy)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+// Setting a PvAccessServer variable with a value of its own type: the value is published as is.
+static void BM_PVAServerSetValueMatchingType(benchmark::State& state)
+{
+  auto array_type = Float64ArrayType(state);
+  Workspace ws;
+  SetupServerWorkspace(ws, state, "matching");
+  sup::dto::AnyValue value{array_type};
+  auto bytes_per_copy = BytesPerCopy(value);
+  auto before = benchmark_utils::GetAllocationSnapshot();
+  for (auto _ : state)
+  {
+    bool result = ws.SetValue(SERVER_VARIABLE, value);
+    benchmark::DoNotOptimize(result);
+  }
+  SetCopyCounters(state, before, bytes_per_copy);
+  ws.Teardown();
+}
+BENCHMARK(BM_PVAServerSetValueMatchingType)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+namespace
+{
+sup::dto::AnyType Float64ArrayType(const benchmark::State& state)
+{
+  auto n_elements = static_cast<std::size_t>(state.range(0));
+  return sup::dto::AnyType{n_elements, sup::dto::Float64Type, "float64[]"};
+}
+
+void SetupServerWorkspace(Workspace& ws, const benchmark::State& state, const std::string& name)
+{
+  auto n_elements = std::to_string(state.range(0));
+  auto variable = std::make_unique<PvAccessServerVariable>();
+  (void)variable->AddAttribute("channel",
+                               "oac-tree-epics-benchmark:" + name + "-array-" + n_elements);
+  (void)variable->AddAttribute(
+    "type", R"({"type":"float64[]","multiplicity":)" + n_elements +
+            R"(,"element":{"type":"float64"}})");
+  (void)ws.AddVariable(SERVER_VARIABLE, std::move(variable));
+  ws.Setup();
+}
+
+std::size_t BytesPerCopy(const sup::dto::AnyValue& value)
+{
+  auto before = benchmark_utils::GetAllocationSnapshot();
+  sup::dto::AnyValue copy{value};
+  benchmark::DoNotOptimize(copy);
+  return (benchmark_utils::GetAllocationSnapshot() - before).bytes;
+}
+
+void SetCopyCounters(benchmark::State& state, const benchmark_utils::AllocationSnapshot& before,
+                     std::size_t bytes_per_copy)
+{
+  auto allocated = benchmark_utils::GetAllocationSnapshot() - before;
+  auto iterations = static_cast<double>(state.iterations());
+  state.counters["copies_per_update"] =
+    static_cast<double>(allocated.bytes) / (static_cast<double>(bytes_per_copy) * iterations);
+  state.counters["allocs_per_update"] = static_cast<double>(allocated.allocations) / iterations;
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          static_cast<std::int64_t>(sizeof(sup::dto::float64)));
+}
+}  // unnamed namespace
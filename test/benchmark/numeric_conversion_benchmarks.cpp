@@ -0,0 +1,76 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/dto/anyvalue_helper.h>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// Array of 'size' unsigned integers, as received from a uint32 waveform.
+sup::dto::AnyValue CreateUInt32Array(std::size_t size);
+}  // unnamed namespace
+
+// Current path: element by element conversion through sup-dto.
+static void BM_ConvertArrayGeneric(benchmark::State& state)
+{
+  auto src = CreateUInt32Array(state.range(0));
+  sup::dto::AnyType dest_type{src.NumberOfElements(), sup::dto::Float64Type};
+  for (auto _ : state)
+  {
+    auto converted = sup::dto::TryConvertAllowExtraSourceFields(src, dest_type);
+    benchmark::DoNotOptimize(converted);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertArrayGeneric)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+// Generic assignment into an existing array of the destination type.
+static void BM_ConvertArrayTryAssign(benchmark::State& state)
+{
+  auto src = CreateUInt32Array(state.range(0));
+  sup::dto::AnyValue dest{sup::dto::AnyType{src.NumberOfElements(), sup::dto::Float64Type}};
+  for (auto _ : state)
+  {
+    if (!sup::dto::TryAssign(dest, src))
+    {
+      state.SkipWithError("Assignment failed");
+      break;
+    }
+    benchmark::DoNotOptimize(dest);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertArrayTryAssign)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+namespace
+{
+sup::dto::AnyValue CreateUInt32Array(std::size_t size)
+{
+  sup::dto::AnyValue result{sup::dto::AnyType{size, sup::dto::UnsignedInteger32Type}};
+  for (std::size_t idx = 0; idx < size; ++idx)
+  {
+    result[idx] = static_cast<sup::dto::uint32>(idx);
+  }
+  return result;
+}
+}  // unnamed namespace
@@ -0,0 +1,307 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include <sup/epics-test/softioc_runner.h>
+#include <sup/oac-tree/sequence_parser.h>
+#include <sup/oac-tree/user_interface.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+using namespace sup::oac_tree;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+const std::chrono::seconds PROCEDURE_TIMEOUT{120};
+
+const std::string PINGPONG_DB = R"RAW(
+record(longout, "SEQ-TEST:PING")
+{
+  field(DESC, "Ping")
+  field(VAL, "0")
+  field(PINI, "YES")
+}
+
+record (longout,"SEQ-TEST:PONG")
+{
+  field(DESC, "Pong")
+  field(VAL, "0")
+  field(PINI, "YES")
+}
+)RAW";
+
+struct Options
+{
+  std::size_t limit;
+  bool run_ca;
+  bool run_pva;
+};
+
+/**
+ * @brief User interface of the ping side: every Output instruction marks the start of a new
+ * round trip.
+ */
+class RoundTripRecorder : public DefaultUserInterface
+{
+public:
+  explicit RoundTripRecorder(std::size_t capacity);
+  ~RoundTripRecorder() override;
+
+  bool PutValue(const sup::dto::AnyValue& value, const std::string& description) override;
+
+  const std::vector<Clock::time_point>& GetTimestamps() const;
+
+private:
+  std::vector<Clock::time_point> m_timestamps;
+};
+
+bool ParseOptions(int argc, char* argv[], Options& options);
+
+// Procedure bodies, adapted from the former functional ping-pong tests.
+std::string CAPingBody(std::size_t limit);
+std::string CAPongBody(std::size_t limit);
+std::string PVAPingBody(std::size_t limit);
+std::string PVAPongBody(std::size_t limit);
+
+bool RunPingPong(const std::string& label, const std::string& ping_body,
+                 const std::string& pong_body, std::size_t limit);
+}  // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+  Options options{10000, true, true};
+  if (!ParseOptions(argc, argv, options))
+  {
+    std::cerr << "Usage: " << argv[0] << " [--limit N] [--protocol ca|pva|all]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  benchmark_utils::UseLocalEpicsAddressLists();
+  benchmark_utils::PrintLatencyHeader("updates/s");
+  bool success = true;
+  if (options.run_ca)
+  {
+    sup::epics::test::SoftIocRunner softioc{"oac-tree-epics-pingpong"};
+    softioc.Start(PINGPONG_DB);
+    success = RunPingPong("ChannelAccessClient", CAPingBody(options.limit),
+                          CAPongBody(options.limit), options.limit) && success;
+    softioc.Stop();
+  }
+  if (options.run_pva)
+  {
+    success = RunPingPong("PvAccessServer/Client", PVAPingBody(options.limit),
+                          PVAPongBody(options.limit), options.limit) && success;
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+namespace
+{
+RoundTripRecorder::RoundTripRecorder(std::size_t capacity)
+  : m_timestamps{}
+{
+  m_timestamps.reserve(capacity);
+}
+
+RoundTripRecorder::~RoundTripRecorder() = default;
+
+bool RoundTripRecorder::PutValue(const sup::dto::AnyValue& value, const std::string& description)
+{
+  (void)value;
+  (void)description;
+  m_timestamps.push_back(Clock::now());
+  return true;
+}
+
+const std::vector<Clock::time_point>& RoundTripRecorder::GetTimestamps() const
+{
+  return m_timestamps;
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+  for (int idx = 1; idx < argc; ++idx)
+  {
+    if (idx + 1 >= argc)
+    {
+      return false;
+    }
+    std::string option{argv[idx]};
+    std::string value{argv[++idx]};
+    if (option == "--limit")
+    {
+      options.limit = std::strtoul(value.c_str(), nullptr, 10);
+      if (options.limit < 2)
+      {
+        return false;
+      }
+    }
+    else if (option == "--protocol")
+    {
+      options.run_ca = (value == "ca" || value == "all");
+      options.run_pva = (value == "pva" || value == "all");
+      if (!options.run_ca && !options.run_pva)
+      {
+        return false;
+      }
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string ListenBody(const std::string& condition, const std::string& own_var)
+{
+  return R"RAW(
+    <Sequence>
+        <WaitForVariable varName="num1" timeout="5.0"/>
+        <WaitForVariable varName="num2" timeout="5.0"/>
+        <Listen varNames="num1,num2">
+            <Sequence>
+                <LessThan leftVar="num2" rightVar="limit"/>
+                <Fallback>
+                    )RAW" + condition + R"RAW(
+                    <Sequence>
+                        <Copy inputVar=")RAW" + own_var + R"RAW(" outputVar="cache"/>
+                        <Increment varName="cache"/>
+                        <Increment varName=")RAW" + own_var + R"RAW("/>
+                        <Output fromVar="cache"/>
+                    </Sequence>
+                </Fallback>
+            </Sequence>
+        </Listen>
+    </Sequence>)RAW";
+}
+
+std::string LocalVariables(const std::string& type, std::size_t limit)
+{
+  return R"RAW(
+        <Local name="limit"
+               type='{"type":")RAW" + type + R"RAW("}'
+               value=')RAW" + std::to_string(limit) + R"RAW('/>
+        <Local name="cache"
+               type='{"type":")RAW" + type + R"RAW("}'/>)RAW";
+}
+
+std::string CAClientVariables()
+{
+  return R"RAW(
+        <ChannelAccessClient name="num1"
+                        channel="SEQ-TEST:PING"
+                        type='{"type":"int32"}'/>
+        <ChannelAccessClient name="num2"
+                        channel="SEQ-TEST:PONG"
+                        type='{"type":"int32"}'/>)RAW";
+}
+
+std::string CAPingBody(std::size_t limit)
+{
+  return ListenBody(R"RAW(<LessThan leftVar="num2" rightVar="num1"/>)RAW", "num1") +
+         "\n    <Workspace>" + CAClientVariables() + LocalVariables("int32", limit) +
+         "\n    </Workspace>\n";
+}
+
+std::string CAPongBody(std::size_t limit)
+{
+  return ListenBody(R"RAW(<LessThanOrEqual leftVar="num1" rightVar="num2"/>)RAW", "num2") +
+         "\n    <Workspace>" + CAClientVariables() + LocalVariables("int32", limit) +
+         "\n    </Workspace>\n";
+}
+
+std::string PVAPingBody(std::size_t limit)
+{
+  return ListenBody(R"RAW(<LessThan leftVar="num2" rightVar="num1"/>)RAW", "num1") +
+         R"RAW(
+    <Workspace>
+        <PvAccessServer name="num1"
+                        channel="seq::test::bounce_1"
+                        type='{"type":"uint64"}'
+                        value='0'/>
+        <PvAccessServer name="num2"
+                        channel="seq::test::bounce_2"
+                        type='{"type":"uint64"}'
+                        value='0'/>)RAW" + LocalVariables("uint64", limit) +
+         "\n    </Workspace>\n";
+}
+
+std::string PVAPongBody(std::size_t limit)
+{
+  return ListenBody(R"RAW(<LessThanOrEqual leftVar="num1" rightVar="num2"/>)RAW", "num2") +
+         R"RAW(
+    <Workspace>
+        <PvAccessClient name="num1"
+                        channel="seq::test::bounce_1"
+                        type='{"type":"uint64"}'/>
+        <PvAccessClient name="num2"
+                        channel="seq::test::bounce_2"
+                        type='{"type":"uint64"}'/>)RAW" + LocalVariables("uint64", limit) +
+         "\n    </Workspace>\n";
+}
+
+bool RunPingPong(const std::string& label, const std::string& ping_body,
+                 const std::string& pong_body, std::size_t limit)
+{
+  auto ping = ParseProcedureString(benchmark_utils::CreateProcedureString(ping_body));
+  auto pong = ParseProcedureString(benchmark_utils::CreateProcedureString(pong_body));
+  if (!ping || !pong)
+  {
+    std::cerr << label << ": could not parse ping-pong procedures" << std::endl;
+    return false;
+  }
+  RoundTripRecorder ping_ui{limit};
+  DefaultUserInterface pong_ui;
+  std::thread pong_thread{[&pong, &pong_ui]() {
+    (void)benchmark_utils::RunProcedure(*pong, pong_ui, PROCEDURE_TIMEOUT);
+  }};
+  (void)benchmark_utils::RunProcedure(*ping, ping_ui, PROCEDURE_TIMEOUT);
+  pong_thread.join();
+
+  // Both procedures end when 'num2' reaches the limit, so their final status is not relevant.
+  const auto& timestamps = ping_ui.GetTimestamps();
+  if (timestamps.size() < 2)
+  {
+    std::cerr << label << ": no round trips recorded" << std::endl;
+    return false;
+  }
+  std::vector<double> latencies;
+  latencies.reserve(timestamps.size() - 1);
+  for (std::size_t idx = 1; idx < timestamps.size(); ++idx)
+  {
+    std::chrono::duration<double, std::micro> round_trip = timestamps[idx] - timestamps[idx - 1];
+    latencies.push_back(round_trip.count());
+  }
+  std::chrono::duration<double> elapsed = timestamps.back() - timestamps.front();
+  // Every round trip consists of one update of each variable
+  auto updates_per_second = 2.0 * static_cast<double>(latencies.size()) / elapsed.count();
+  benchmark_utils::PrintLatencyStatistics(
+    label, benchmark_utils::ComputeLatencyStatistics(std::move(latencies)), updates_per_second);
+  return true;
+}
+}  // unnamed namespace
@@ -0,0 +1,369 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include <sup/oac-tree/sequence_parser.h>
+#include <sup/oac-tree/user_interface.h>
+
+#include <sup/epics/pv_access_rpc_client.h>
+#include <sup/epics/pv_access_rpc_server.h>
+#include <sup/protocol/protocol_rpc.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace sup::oac_tree;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+const std::string SERVICE_NAME = "rpc-benchmark::service";
+
+const std::string RPC_CLIENT_BODY = R"RAW(
+    <RPCClient service="rpc-benchmark::service"
+               requestVar="request"
+               outputVar="reply"/>
+    <Workspace>
+        <Local name="request"
+               type='{"type":"sup::RPCRequest/v1.0","attributes":[{"timestamp":{"type":"uint64"}},{"query":{"type":"uint16"}}]}'
+               value='{"timestamp":0,"query":42}'/>
+        <Local name="reply"/>
+    </Workspace>
+)RAW";
+
+enum class CallMode
+{
+  INSTRUCTION = 0,  // RPCClient instruction in a procedure
+  NEW_CLIENT,       // PvAccessRPCClient created for each call, as done by the instruction
+  SHARED_CLIENT     // Single PvAccessRPCClient per thread
+};
+
+struct Options
+{
+  std::size_t n_calls;
+  std::vector<std::size_t> concurrencies;
+  std::vector<CallMode> modes;
+};
+
+/**
+ * @brief Trivial service: replies with the query of the request.
+ */
+class EchoHandler : public sup::dto::AnyFunctor
+{
+public:
+  EchoHandler();
+  ~EchoHandler() override;
+
+  sup::dto::AnyValue operator()(const sup::dto::AnyValue& input) override;
+};
+
+bool ParseOptions(int argc, char* argv[], Options& options);
+
+bool ParseConcurrencies(const std::string& concurrencies_str,
+                        std::vector<std::size_t>& concurrencies);
+
+std::string ModeName(CallMode mode);
+
+// Same request as the one defined in the procedure for the RPCClient instruction.
+sup::dto::AnyValue CreateRequest();
+
+bool IsSuccessfulReply(const sup::dto::AnyValue& reply);
+
+// Each function performs n_calls sequential calls and appends their latencies in microseconds.
+// They return the number of failed calls.
+std::size_t CallWithInstruction(std::size_t n_calls, std::vector<double>& latencies);
+std::size_t CallWithNewClient(std::size_t n_calls, std::vector<double>& latencies);
+std::size_t CallWithSharedClient(std::size_t n_calls, std::vector<double>& latencies);
+
+bool RunRPCBenchmark(CallMode mode, std::size_t concurrency, std::size_t n_calls);
+}  // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+  Options options{1000, {1, 4, 16},
+                  {CallMode::INSTRUCTION, CallMode::NEW_CLIENT, CallMode::SHARED_CLIENT}};
+  if (!ParseOptions(argc, argv, options))
+  {
+    std::cerr << "Usage: " << argv[0] << " [--calls N] [--concurrency C[,C...]] "
+              << "[--mode instruction|new-client|shared-client|all]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  benchmark_utils::UseLocalEpicsAddressLists();
+  EchoHandler handler;
+  auto server_config = sup::epics::GetDefaultRPCServerConfig(SERVICE_NAME);
+  sup::epics::PvAccessRPCServer server{server_config, handler};
+  benchmark_utils::PrintLatencyHeader("calls/s");
+  bool success = true;
+  for (auto mode : options.modes)
+  {
+    for (auto concurrency : options.concurrencies)
+    {
+      success = RunRPCBenchmark(mode, concurrency, options.n_calls) && success;
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+namespace
+{
+EchoHandler::EchoHandler() = default;
+
+EchoHandler::~EchoHandler() = default;
+
+sup::dto::AnyValue EchoHandler::operator()(const sup::dto::AnyValue& input)
+{
+  return sup::protocol::utils::CreateRPCReply(sup::protocol::Success, input["query"],
+                                              sup::protocol::PayloadEncoding::kNone);
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+  for (int idx = 1; idx < argc; ++idx)
+  {
+    if (idx + 1 >= argc)
+    {
+      return false;
+    }
+    std::string option{argv[idx]};
+    std::string value{argv[++idx]};
+    if (option == "--calls")
+    {
+      options.n_calls = std::strtoul(value.c_str(), nullptr, 10);
+      if (options.n_calls == 0)
+      {
+        return false;
+      }
+    }
+    else if (option == "--concurrency")
+    {
+      if (!ParseConcurrencies(value, options.concurrencies))
+      {
+        return false;
+      }
+    }
+    else if (option == "--mode")
+    {
+      if (value == "instruction")
+      {
+        options.modes = {CallMode::INSTRUCTION};
+      }
+      else if (value == "new-client")
+      {
+        options.modes = {CallMode::NEW_CLIENT};
+      }
+      else if (value == "shared-client")
+      {
+        options.modes = {CallMode::SHARED_CLIENT};
+      }
+      else if (value != "all")
+      {
+        return false;
+      }
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParseConcurrencies(const std::string& concurrencies_str,
+                        std::vector<std::size_t>& concurrencies)
+{
+  std::vector<std::size_t> result;
+  std::istringstream iss{concurrencies_str};
+  std::string concurrency_str;
+  while (std::getline(iss, concurrency_str, ','))
+  {
+    auto concurrency = std::strtoul(concurrency_str.c_str(), nullptr, 10);
+    if (concurrency == 0)
+    {
+      return false;
+    }
+    result.push_back(concurrency);
+  }
+  if (result.empty())
+  {
+    return false;
+  }
+  concurrencies = std::move(result);
+  return true;
+}
+
+std::string ModeName(CallMode mode)
+{
+  switch (mode)
+  {
+  case CallMode::INSTRUCTION:
+    return "RPCClient";
+  case CallMode::NEW_CLIENT:
+    return "new client";
+  case CallMode::SHARED_CLIENT:
+    return "shared client";
+  }
+  return "unknown";
+}
+
+sup::dto::AnyValue CreateRequest()
+{
+  return {{
+    {"timestamp", {sup::dto::UnsignedInteger64Type, 0}},
+    {"query", {sup::dto::UnsignedInteger16Type, 42}}
+  }, "sup::RPCRequest/v1.0"};
+}
+
+bool IsSuccessfulReply(const sup::dto::AnyValue& reply)
+{
+  return sup::protocol::utils::CheckReplyFormat(reply) &&
+         reply[sup::protocol::constants::REPLY_RESULT].As<sup::dto::uint32>() ==
+           sup::protocol::Success.GetValue();
+}
+
+std::size_t CallWithInstruction(std::size_t n_calls, std::vector<double>& latencies)
+{
+  auto proc = ParseProcedureString(benchmark_utils::CreateProcedureString(RPC_CLIENT_BODY));
+  if (!proc)
+  {
+    return n_calls;
+  }
+  DefaultUserInterface ui;
+  proc->Setup();
+  std::size_t n_failed = 0;
+  for (std::size_t idx = 0; idx < n_calls; ++idx)
+  {
+    auto start = Clock::now();
+    auto status = ExecutionStatus::NOT_STARTED;
+    do
+    {
+      proc->ExecuteSingle(ui);
+      status = proc->GetStatus();
+      if (status == ExecutionStatus::RUNNING)
+      {
+        std::this_thread::yield();
+      }
+    } while (status != ExecutionStatus::SUCCESS && status != ExecutionStatus::FAILURE);
+    std::chrono::duration<double, std::micro> latency = Clock::now() - start;
+    latencies.push_back(latency.count());
+    if (status != ExecutionStatus::SUCCESS)
+    {
+      ++n_failed;
+    }
+    proc->Reset(ui);
+  }
+  return n_failed;
+}
+
+std::size_t CallWithNewClient(std::size_t n_calls, std::vector<double>& latencies)
+{
+  auto request = CreateRequest();
+  auto client_config = sup::epics::GetDefaultRPCClientConfig(SERVICE_NAME);
+  std::size_t n_failed = 0;
+  for (std::size_t idx = 0; idx < n_calls; ++idx)
+  {
+    auto start = Clock::now();
+    sup::epics::PvAccessRPCClient rpc_client{client_config};
+    auto reply = rpc_client(request);
+    std::chrono::duration<double, std::micro> latency = Clock::now() - start;
+    latencies.push_back(latency.count());
+    if (!IsSuccessfulReply(reply))
+    {
+      ++n_failed;
+    }
+  }
+  return n_failed;
+}
+
+std::size_t CallWithSharedClient(std::size_t n_calls, std::vector<double>& latencies)
+{
+  auto request = CreateRequest();
+  auto client_config = sup::epics::GetDefaultRPCClientConfig(SERVICE_NAME);
+  sup::epics::PvAccessRPCClient rpc_client{client_config};
+  std::size_t n_failed = 0;
+  for (std::size_t idx = 0; idx < n_calls; ++idx)
+  {
+    auto start = Clock::now();
+    auto reply = rpc_client(request);
+    std::chrono::duration<double, std::micro> latency = Clock::now() - start;
+    latencies.push_back(latency.count());
+    if (!IsSuccessfulReply(reply))
+    {
+      ++n_failed;
+    }
+  }
+  return n_failed;
+}
+
+bool RunRPCBenchmark(CallMode mode, std::size_t concurrency, std::size_t n_calls)
+{
+  std::vector<std::vector<double>> thread_latencies(concurrency);
+  std::vector<std::size_t> thread_failures(concurrency, 0);
+  std::vector<std::thread> threads;
+  auto start = Clock::now();
+  for (std::size_t idx = 0; idx < concurrency; ++idx)
+  {
+    threads.emplace_back([mode, n_calls, &latencies = thread_latencies[idx],
+                          &n_failed = thread_failures[idx]]() {
+      latencies.reserve(n_calls);
+      switch (mode)
+      {
+      case CallMode::INSTRUCTION:
+        n_failed = CallWithInstruction(n_calls, latencies);
+        break;
+      case CallMode::NEW_CLIENT:
+        n_failed = CallWithNewClient(n_calls, latencies);
+        break;
+      case CallMode::SHARED_CLIENT:
+        n_failed = CallWithSharedClient(n_calls, latencies);
+        break;
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  std::vector<double> latencies;
+  std::size_t n_failed = 0;
+  for (std::size_t idx = 0; idx < concurrency; ++idx)
+  {
+    latencies.insert(latencies.end(), thread_latencies[idx].begin(), thread_latencies[idx].end());
+    n_failed += thread_failures[idx];
+  }
+  auto n_succeeded = latencies.size() - n_failed;
+  auto calls_per_second = static_cast<double>(n_succeeded) / elapsed.count();
+  auto label = ModeName(mode) + " x" + std::to_string(concurrency);
+  benchmark_utils::PrintLatencyStatistics(
+    label, benchmark_utils::ComputeLatencyStatistics(std::move(latencies)), calls_per_second);
+  if (n_failed > 0)
+  {
+    std::cerr << label << ": " << n_failed << " calls failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+}  // unnamed namespace
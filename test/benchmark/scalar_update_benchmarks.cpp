@@ -0,0 +1,97 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <oac-tree/common/scalar_conversion.h>
+#include <oac-tree/pvxs/pv_access_helper.h>
+
+#include <sup/dto/anyvalue_helper.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace sup::oac_tree;
+
+namespace
+{
+// Update as received by a PvAccessClient variable for a scalar channel.
+sup::dto::AnyValue CreateScalarUpdate(const sup::dto::AnyValue& value);
+
+// Pairs of source and declared types: identical float64, int32 to float64 and identical bool.
+sup::dto::AnyValue SourceValue(const benchmark::State& state);
+sup::dto::AnyType DeclaredType(const benchmark::State& state);
+}  // unnamed namespace
+
+// Converting a scalar update with the generic sup-dto conversion.
+static void BM_PVAScalarUpdateGeneric(benchmark::State& state)
+{
+  auto update = CreateScalarUpdate(SourceValue(state));
+  auto anytype = DeclaredType(state);
+  for (auto _ : state)
+  {
+    auto value = pv_access_helper::ConvertToTypedAnyValue(update, anytype);
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(BM_PVAScalarUpdateGeneric)->DenseRange(0, 2);
+
+// Converting a scalar update with the specialized converter selected on the first update.
+static void BM_PVAScalarUpdateSpecialized(benchmark::State& state)
+{
+  auto update = CreateScalarUpdate(SourceValue(state));
+  auto anytype = DeclaredType(state);
+  epics_helper::ScalarConversion conversion{anytype};
+  for (auto _ : state)
+  {
+    auto value = pv_access_helper::ConvertToTypedAnyValue(update, anytype, conversion);
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(BM_PVAScalarUpdateSpecialized)->DenseRange(0, 2);
+
+namespace
+{
+sup::dto::AnyValue CreateScalarUpdate(const sup::dto::AnyValue& value)
+{
+  sup::dto::AnyValue result = {{
+    { pv_access_helper::VALUE_FIELD_NAME, value }
+  }};
+  return result;
+}
+
+sup::dto::AnyValue SourceValue(const benchmark::State& state)
+{
+  switch (state.range(0))
+  {
+  case 1:
+    return sup::dto::AnyValue{sup::dto::SignedInteger32Type, 1729};
+  case 2:
+    return sup::dto::AnyValue{sup::dto::BooleanType, true};
+  default:
+    break;
+  }
+  return sup::dto::AnyValue{sup::dto::Float64Type, 3.14};
+}
+
+sup::dto::AnyType DeclaredType(const benchmark::State& state)
+{
+  return state.range(0) == 2 ? sup::dto::BooleanType : sup::dto::Float64Type;
+}
+}  // unnamed namespace
@@ -0,0 +1,84 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "allocation_counter.h"
+
+#include <oac-tree/pvxs/pv_access_helper.h>
+
+#include <sup/dto/anyvalue_helper.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace sup::oac_tree;
+
+namespace
+{
+// Report the number of heap allocations per write.
+void SetAllocationCounters(benchmark::State& state,
+                           const benchmark_utils::AllocationSnapshot& before);
+}  // unnamed namespace
+
+// Preparing a scalar write for PvAccessClient/PvAccessServer, as before the wire value template.
+static void BM_PVAScalarWriteAllocate(benchmark::State& state)
+{
+  sup::dto::AnyType anytype{sup::dto::Float64Type};
+  sup::dto::AnyValue value{sup::dto::SignedInteger32Type, 0};
+  auto before = benchmark_utils::GetAllocationSnapshot();
+  for (auto _ : state)
+  {
+    sup::dto::AnyValue copy(anytype);
+    sup::dto::TryConvert(copy, value);
+    auto packed = pv_access_helper::PackIntoStructIfScalar(std::move(copy));
+    benchmark::DoNotOptimize(packed);
+  }
+  SetAllocationCounters(state, before);
+}
+BENCHMARK(BM_PVAScalarWriteAllocate);
+
+// Preparing a scalar write by converting into the wire value template of the variable.
+static void BM_PVAScalarWriteTemplate(benchmark::State& state)
+{
+  sup::dto::AnyType anytype{sup::dto::Float64Type};
+  sup::dto::AnyValue value{sup::dto::SignedInteger32Type, 0};
+  auto wire_value = pv_access_helper::CreateWireValue(anytype);
+  auto before = benchmark_utils::GetAllocationSnapshot();
+  for (auto _ : state)
+  {
+    bool converted = pv_access_helper::ConvertIntoWireValue(wire_value, anytype, value);
+    benchmark::DoNotOptimize(converted);
+    benchmark::DoNotOptimize(wire_value);
+  }
+  SetAllocationCounters(state, before);
+}
+BENCHMARK(BM_PVAScalarWriteTemplate);
+
+namespace
+{
+void SetAllocationCounters(benchmark::State& state,
+                           const benchmark_utils::AllocationSnapshot& before)
+{
+  auto allocated = benchmark_utils::GetAllocationSnapshot() - before;
+  auto iterations = static_cast<double>(state.iterations());
+  state.counters["allocs_per_write"] = static_cast<double>(allocated.allocations) / iterations;
+  state.counters["bytes_per_write"] = static_cast<double>(allocated.bytes) / iterations;
+}
+}  // unnamed namespace
@@ -0,0 +1,322 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Benchmark code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "benchmark_utils.h"
+
+#include <sup/epics-test/softioc_runner.h>
+#include <sup/oac-tree/variable.h>
+#include <sup/oac-tree/variable_registry.h>
+#include <sup/oac-tree/workspace.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+using namespace sup::oac_tree;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+const std::string CA_CHANNEL_PREFIX = "SCALE-TEST:VAR-";
+const std::string PVA_CHANNEL_PREFIX = "scale-test::var-";
+const std::string VARIABLE_TYPE = R"RAW({"type":"float64"})RAW";
+
+enum class VariableKind
+{
+  CA_CLIENT = 0,
+  PVA_CLIENT,
+  PVA_SERVER
+};
+
+struct Options
+{
+  std::vector<std::size_t> counts;
+  std::vector<VariableKind> kinds;
+  double connect_timeout;
+};
+
+/**
+ * @brief Timings in milliseconds and memory footprint of one workspace with N variables.
+ */
+struct ScaleResult
+{
+  std::size_t n_connected;
+  double create_ms;
+  double setup_ms;
+  double connect_ms;
+  double teardown_ms;
+  double rss_per_variable;
+};
+
+bool ParseOptions(int argc, char* argv[], Options& options);
+
+bool ParseCounts(const std::string& counts_str, std::vector<std::size_t>& counts);
+
+std::string KindName(VariableKind kind);
+
+// Soft IOC database with one analog output record per variable.
+std::string GenerateSoftIocDatabase(std::size_t n_records);
+
+// Workspace with n_vars variables of the given type, connecting to the generated channels.
+std::unique_ptr<Workspace> GenerateWorkspace(const std::string& var_type,
+                                             const std::string& channel_prefix,
+                                             std::size_t n_vars);
+
+ScaleResult MeasureScaling(const std::string& var_type, const std::string& channel_prefix,
+                           std::size_t n_vars, double connect_timeout);
+
+double ElapsedMilliseconds(Clock::time_point start);
+
+void PrintScaleHeader();
+
+void PrintScaleResult(VariableKind kind, std::size_t n_vars, const ScaleResult& result);
+}  // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+  Options options{{10000, 30000, 100000},
+                  {VariableKind::CA_CLIENT, VariableKind::PVA_CLIENT, VariableKind::PVA_SERVER},
+                  120.0};
+  if (!ParseOptions(argc, argv, options))
+  {
+    std::cerr << "Usage: " << argv[0] << " [--count N[,N...]] "
+              << "[--kind ca-client|pva-client|pva-server|all] [--timeout SECONDS]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  benchmark_utils::UseLocalEpicsAddressLists();
+  PrintScaleHeader();
+  bool success = true;
+  for (auto kind : options.kinds)
+  {
+    for (auto n_vars : options.counts)
+    {
+      ScaleResult result{};
+      if (kind == VariableKind::CA_CLIENT)
+      {
+        sup::epics::test::SoftIocRunner softioc{"oac-tree-epics-scale"};
+        softioc.Start(GenerateSoftIocDatabase(n_vars));
+        result = MeasureScaling("ChannelAccessClient", CA_CHANNEL_PREFIX, n_vars,
+                                options.connect_timeout);
+        softioc.Stop();
+      }
+      else if (kind == VariableKind::PVA_CLIENT)
+      {
+        // The served channels are hosted by a separate workspace that is not measured
+        auto server_ws = GenerateWorkspace("PvAccessServer", PVA_CHANNEL_PREFIX, n_vars);
+        server_ws->Setup();
+        result = MeasureScaling("PvAccessClient", PVA_CHANNEL_PREFIX, n_vars,
+                                options.connect_timeout);
+        server_ws->Teardown();
+      }
+      else
+      {
+        result = MeasureScaling("PvAccessServer", PVA_CHANNEL_PREFIX, n_vars,
+                                options.connect_timeout);
+      }
+      PrintScaleResult(kind, n_vars, result);
+      success = (result.n_connected == n_vars) && success;
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+namespace
+{
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+  for (int idx = 1; idx < argc; ++idx)
+  {
+    if (idx + 1 >= argc)
+    {
+      return false;
+    }
+    std::string option{argv[idx]};
+    std::string value{argv[++idx]};
+    if (option == "--count")
+    {
+      if (!ParseCounts(value, options.counts))
+      {
+        return false;
+      }
+    }
+    else if (option == "--kind")
+    {
+      if (value == "ca-client")
+      {
+        options.kinds = {VariableKind::CA_CLIENT};
+      }
+      else if (value == "pva-client")
+      {
+        options.kinds = {VariableKind::PVA_CLIENT};
+      }
+      else if (value == "pva-server")
+      {
+        options.kinds = {VariableKind::PVA_SERVER};
+      }
+      else if (value != "all")
+      {
+        return false;
+      }
+    }
+    else if (option == "--timeout")
+    {
+      options.connect_timeout = std::strtod(value.c_str(), nullptr);
+      if (options.connect_timeout <= 0.0)
+      {
+        return false;
+      }
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParseCounts(const std::string& counts_str, std::vector<std::size_t>& counts)
+{
+  std::vector<std::size_t> result;
+  std::istringstream iss{counts_str};
+  std::string count_str;
+  while (std::getline(iss, count_str, ','))
+  {
+    auto count = std::strtoul(count_str.c_str(), nullptr, 10);
+    if (count == 0)
+    {
+      return false;
+    }
+    result.push_back(count);
+  }
+  if (result.empty())
+  {
+    return false;
+  }
+  counts = std::move(result);
+  return true;
+}
+
+std::string KindName(VariableKind kind)
+{
+  switch (kind)
+  {
+  case VariableKind::CA_CLIENT:
+    return "ChannelAccessClient";
+  case VariableKind::PVA_CLIENT:
+    return "PvAccessClient";
+  case VariableKind::PVA_SERVER:
+    return "PvAccessServer";
+  }
+  return "Unknown";
+}
+
+std::string GenerateSoftIocDatabase(std::size_t n_records)
+{
+  std::ostringstream oss;
+  for (std::size_t idx = 0; idx < n_records; ++idx)
+  {
+    oss << "record(ao, \"" << CA_CHANNEL_PREFIX << idx << "\")\n"
+        << "{\n"
+        << "  field(VAL, \"" << idx << "\")\n"
+        << "  field(PINI, \"YES\")\n"
+        << "}\n";
+  }
+  return oss.str();
+}
+
+std::unique_ptr<Workspace> GenerateWorkspace(const std::string& var_type,
+                                             const std::string& channel_prefix,
+                                             std::size_t n_vars)
+{
+  auto workspace = std::make_unique<Workspace>();
+  for (std::size_t idx = 0; idx < n_vars; ++idx)
+  {
+    auto variable = GlobalVariableRegistry().Create(var_type);
+    (void)variable->AddAttribute("channel", channel_prefix + std::to_string(idx));
+    (void)variable->AddAttribute("type", VARIABLE_TYPE);
+    (void)workspace->AddVariable("var" + std::to_string(idx), std::move(variable));
+  }
+  return workspace;
+}
+
+ScaleResult MeasureScaling(const std::string& var_type, const std::string& channel_prefix,
+                           std::size_t n_vars, double connect_timeout)
+{
+  ScaleResult result{};
+  auto rss_before = benchmark_utils::GetResidentMemory();
+  auto start = Clock::now();
+  auto workspace = GenerateWorkspace(var_type, channel_prefix, n_vars);
+  result.create_ms = ElapsedMilliseconds(start);
+
+  start = Clock::now();
+  workspace->Setup();
+  result.setup_ms = ElapsedMilliseconds(start);
+
+  // Connection time includes the setup; waiting for each variable in turn means the total is
+  // determined by the slowest connection
+  auto deadline = start + std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<double>(connect_timeout));
+  for (const auto& var_name : workspace->VariableNames())
+  {
+    std::chrono::duration<double> remaining = deadline - Clock::now();
+    if (remaining.count() <= 0.0 || !workspace->WaitForVariable(var_name, remaining.count()))
+    {
+      break;
+    }
+    ++result.n_connected;
+  }
+  result.connect_ms = ElapsedMilliseconds(start);
+  auto rss_after = benchmark_utils::GetResidentMemory();
+  result.rss_per_variable = rss_after > rss_before
+    ? static_cast<double>(rss_after - rss_before) / static_cast<double>(n_vars)
+    : 0.0;
+
+  start = Clock::now();
+  workspace->Teardown();
+  result.teardown_ms = ElapsedMilliseconds(start);
+  workspace.reset();
+  return result;
+}
+
+double ElapsedMilliseconds(Clock::time_point start)
+{
+  std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+  return elapsed.count();
+}
+
+void PrintScaleHeader()
+{
+  std::printf("%-20s %8s %10s %11s %10s %12s %13s %14s\n", "Variable", "N", "connected",
+              "create[ms]", "setup[ms]", "connect[ms]", "teardown[ms]", "RSS/var[byte]");
+}
+
+void PrintScaleResult(VariableKind kind, std::size_t n_vars, const ScaleResult& result)
+{
+  std::printf("%-20s %8zu %10zu %11.1f %10.1f %12.1f %13.1f %14.0f\n", KindName(kind).c_str(),
+              n_vars, result.n_connected, result.create_ms, result.setup_ms, result.connect_ms,
+              result.teardown_ms, result.rss_per_variable);
+  std::fflush(stdout);
+}
+}  // unnamed namespace
@@ -107,6 +107,79 @@ TEST_F(ChannelAccessClientVariableTest, Setup)
   EXPECT_TRUE(var_3->AddAttribute("type", R"RAW({"type":"bool"})RAW"));
   EXPECT_NO_THROW(var_3->Setup(ws));
   EXPECT_NO_THROW(var_3->Teardown());
+
+  // Mode cannot be parsed
+  auto var_4 = GlobalVariableRegistry().Create("ChannelAccessClient");
+  ASSERT_TRUE(static_cast<bool>(var_4));
+  EXPECT_TRUE(var_4->AddAttribute("channel", "DOESNT-MATTER"));
+  EXPECT_TRUE(var_4->AddAttribute("mode", "value"));
+  EXPECT_THROW(var_4->Setup(ws), VariableSetupException);
+
+  // Connection mode does not require a type
+  auto var_5 = GlobalVariableRegistry().Create("ChannelAccessClient");
+  ASSERT_TRUE(static_cast<bool>(var_5));
+  EXPECT_TRUE(var_5->AddAttribute("channel", "DOESNT-MATTER"));
+  EXPECT_TRUE(var_5->AddAttribute("mode", "connection"));
+  EXPECT_NO_THROW(var_5->Setup(ws));
+  EXPECT_NO_THROW(var_5->Teardown());
+}
+
+TEST_F(ChannelAccessClientVariableTest, ConnectionMode)
+{
+  Workspace ws;
+  auto variable = GlobalVariableRegistry().Create("ChannelAccessClient");
+  ASSERT_TRUE(static_cast<bool>(variable));
+  EXPECT_TRUE(variable->AddAttribute("channel", "SEQ-TEST:BOOL"));
+  EXPECT_TRUE(variable->AddAttribute("mode", "connection"));
+  EXPECT_TRUE(ws.AddVariable("var", std::move(variable)));
+  EXPECT_NO_THROW(ws.Setup());
+
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(5.0, [&ws]{
+    sup::dto::AnyValue tmp;
+    return ws.GetValue("var", tmp) && tmp == true;
+  }));
+  EXPECT_FALSE(ws.SetValue("var", false));
+}
+
+TEST_F(ChannelAccessClientVariableTest, MonitorMask)
+{
+  Workspace ws;
+  // Monitor mask cannot be parsed
+  auto var_1 = GlobalVariableRegistry().Create("ChannelAccessClient");
+  ASSERT_TRUE(static_cast<bool>(var_1));
+  EXPECT_TRUE(var_1->AddAttribute("channel", "DOESNT-MATTER"));
+  EXPECT_TRUE(var_1->AddAttribute("type", R"RAW({"type":"bool"})RAW"));
+  EXPECT_TRUE(var_1->AddAttribute("monitorMask", "DBE_VALUE|DBE_UNKNOWN"));
+  EXPECT_THROW(var_1->Setup(ws), VariableSetupException);
+  // Server-side event classes are not supported
+  auto var_3 = GlobalVariableRegistry().Create("ChannelAccessClient");
+  ASSERT_TRUE(static_cast<bool>(var_3));
+  EXPECT_TRUE(var_3->AddAttribute("channel", "DOESNT-MATTER"));
+  EXPECT_TRUE(var_3->AddAttribute("type", R"RAW({"type":"bool"})RAW"));
+  EXPECT_TRUE(var_3->AddAttribute("monitorMask", "DBE_LOG"));
+  EXPECT_THROW(var_3->Setup(ws), VariableSetupException);
+  // Value filtering is restricted to scalar channels
+  auto var_4 = GlobalVariableRegistry().Create("ChannelAccessClient");
+  ASSERT_TRUE(static_cast<bool>(var_4));
+  EXPECT_TRUE(var_4->AddAttribute("channel", "DOESNT-MATTER"));
+  EXPECT_TRUE(var_4->AddAttribute(
+    "type", R"RAW({"type":"uint32[]","multiplicity":8,"element":{"type":"uint32"}})RAW"));
+  EXPECT_TRUE(var_4->AddAttribute("monitorMask", "DBE_VALUE"));
+  EXPECT_THROW(var_4->Setup(ws), VariableSetupException);
+
+  // Alarm-only subscription still provides the value on connection
+  auto var_2 = GlobalVariableRegistry().Create("ChannelAccessClient");
+  ASSERT_TRUE(static_cast<bool>(var_2));
+  EXPECT_TRUE(var_2->AddAttribute("channel", "SEQ-TEST:BOOL"));
+  EXPECT_TRUE(var_2->AddAttribute("type", BOOLCONNECTEDTYPE));
+  EXPECT_TRUE(var_2->AddAttribute("monitorMask", "DBE_ALARM"));
+  EXPECT_TRUE(ws.AddVariable("var", std::move(var_2)));
+  EXPECT_NO_THROW(ws.Setup());
+
+  EXPECT_TRUE(ws.WaitForVariable("var", 5.0));
+  sup::dto::AnyValue connected;
+  ASSERT_TRUE(ws.GetValue("var.connected", connected));
+  EXPECT_TRUE(connected.As<bool>());
 }
 
 TEST_F(ChannelAccessClientVariableTest, GetValueSuccess)
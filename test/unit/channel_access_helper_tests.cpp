@@ -0,0 +1,161 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <oac-tree/ca/channel_access_helper.h>
+
+#include <gtest/gtest.h>
+
+using namespace sup::oac_tree;
+
+class ChannelAccessHelperTest : public ::testing::Test
+{
+protected:
+  ChannelAccessHelperTest();
+  ~ChannelAccessHelperTest();
+
+  static sup::epics::ChannelAccessPV::ExtendedValue CreateExtendedValue(
+    bool connected, const sup::dto::AnyValue& value, sup::dto::int16 status,
+    sup::dto::int16 severity);
+};
+
+TEST_F(ChannelAccessHelperTest, ParseMonitorMask)
+{
+  sup::dto::uint32 mask = 0;
+  EXPECT_TRUE(channel_access_helper::ParseMonitorMask("DBE_VALUE", mask));
+  EXPECT_EQ(mask, channel_access_helper::MONITOR_MASK_VALUE);
+  EXPECT_TRUE(channel_access_helper::ParseMonitorMask(" DBE_VALUE | DBE_ALARM ", mask));
+  EXPECT_EQ(mask, channel_access_helper::MONITOR_MASK_DEFAULT);
+  EXPECT_TRUE(channel_access_helper::ParseMonitorMask("DBE_ALARM", mask));
+  EXPECT_EQ(mask, channel_access_helper::MONITOR_MASK_ALARM);
+
+  // Failures leave the mask untouched
+  EXPECT_FALSE(channel_access_helper::ParseMonitorMask("", mask));
+  EXPECT_FALSE(channel_access_helper::ParseMonitorMask("DBE_VALUE|", mask));
+  EXPECT_FALSE(channel_access_helper::ParseMonitorMask("DBE_VALUE,DBE_ALARM", mask));
+  EXPECT_FALSE(channel_access_helper::ParseMonitorMask("value", mask));
+  // Event classes that need a different subscription mask on the server are rejected
+  EXPECT_FALSE(channel_access_helper::ParseMonitorMask("DBE_LOG", mask));
+  EXPECT_FALSE(channel_access_helper::ParseMonitorMask("DBE_ARCHIVE|DBE_ALARM", mask));
+  EXPECT_FALSE(channel_access_helper::ParseMonitorMask("DBE_PROPERTY", mask));
+  EXPECT_EQ(mask, channel_access_helper::MONITOR_MASK_ALARM);
+}
+
+TEST_F(ChannelAccessHelperTest, UpdateMatchesMonitorMask)
+{
+  using channel_access_helper::UpdateMatchesMonitorMask;
+  const auto value_mask = channel_access_helper::MONITOR_MASK_VALUE;
+  const auto alarm_mask = channel_access_helper::MONITOR_MASK_ALARM;
+  auto initial = CreateExtendedValue(false, {}, 0, 0);
+  auto connected = CreateExtendedValue(true, sup::dto::AnyValue{1.0}, 0, 0);
+  auto value_changed = CreateExtendedValue(true, sup::dto::AnyValue{2.0}, 0, 0);
+  auto alarm_changed = CreateExtendedValue(true, sup::dto::AnyValue{1.0}, 3, 2);
+
+  // Connection changes always pass
+  EXPECT_TRUE(UpdateMatchesMonitorMask(alarm_mask, initial, connected));
+  EXPECT_TRUE(UpdateMatchesMonitorMask(value_mask, connected, initial));
+
+  // Value changes only pass for DBE_VALUE
+  EXPECT_TRUE(UpdateMatchesMonitorMask(value_mask, connected, value_changed));
+  EXPECT_FALSE(UpdateMatchesMonitorMask(alarm_mask, connected, value_changed));
+
+  // Alarm changes only pass for DBE_ALARM
+  EXPECT_TRUE(UpdateMatchesMonitorMask(alarm_mask, connected, alarm_changed));
+  EXPECT_FALSE(UpdateMatchesMonitorMask(value_mask, connected, alarm_changed));
+
+  // Identical updates never pass
+  EXPECT_FALSE(UpdateMatchesMonitorMask(channel_access_helper::MONITOR_MASK_DEFAULT,
+                                        connected, connected));
+}
+
+TEST_F(ChannelAccessHelperTest, ElementRange)
+{
+  channel_access_helper::ElementRange range{2, 3};
+  sup::dto::AnyType slice_type{3, sup::dto::UnsignedInteger32Type, "uint32[]"};
+
+  // Only arrays with the same number of elements as the range are supported
+  EXPECT_TRUE(sup::dto::IsEmptyType(
+    channel_access_helper::RangedChannelType(sup::dto::UnsignedInteger32Type, range)));
+  EXPECT_TRUE(sup::dto::IsEmptyType(channel_access_helper::RangedChannelType(
+    sup::dto::AnyType{4, sup::dto::UnsignedInteger32Type}, range)));
+  auto channel_type = channel_access_helper::RangedChannelType(slice_type, range);
+  sup::dto::AnyType expected_type{5, sup::dto::UnsignedInteger32Type, "uint32[]"};
+  EXPECT_EQ(channel_type, expected_type);
+
+  // A zero count is taken from the array type
+  channel_access_helper::ElementRange default_range{2, 0};
+  EXPECT_EQ(channel_access_helper::RangedChannelType(slice_type, default_range), expected_type);
+  EXPECT_EQ(default_range.count, 3U);
+
+  // Extract the range
+  sup::dto::AnyValue full_value{channel_type};
+  for (sup::dto::uint32 idx = 0; idx < full_value.NumberOfElements(); ++idx)
+  {
+    full_value[idx] = idx;
+  }
+  auto ext_value = CreateExtendedValue(true, full_value, 0, 0);
+  auto result = channel_access_helper::ExtractElementRange(ext_value, range);
+  EXPECT_TRUE(result.connected);
+  ASSERT_EQ(result.value.GetType(), slice_type);
+  EXPECT_EQ(result.value[0], 2U);
+  EXPECT_EQ(result.value[1], 3U);
+  EXPECT_EQ(result.value[2], 4U);
+
+  // Copy the range into an existing value
+  sup::dto::AnyValue range_value{slice_type};
+  EXPECT_TRUE(channel_access_helper::CopyElementRange(range_value, full_value, range));
+  EXPECT_EQ(range_value, result.value);
+  EXPECT_FALSE(channel_access_helper::CopyElementRange(
+    range_value, sup::dto::AnyValue{slice_type}, range));
+  sup::dto::AnyValue wrong_value{sup::dto::AnyType{3, sup::dto::Float64Type}};
+  EXPECT_FALSE(channel_access_helper::CopyElementRange(wrong_value, full_value, range));
+
+  // Non-numeric elements are copied one by one
+  sup::dto::AnyValue full_strings{sup::dto::AnyType{5, sup::dto::StringType}};
+  for (sup::dto::uint32 idx = 0; idx < full_strings.NumberOfElements(); ++idx)
+  {
+    full_strings[idx] = std::to_string(idx);
+  }
+  sup::dto::AnyValue range_strings{sup::dto::AnyType{3, sup::dto::StringType}};
+  EXPECT_TRUE(channel_access_helper::CopyElementRange(range_strings, full_strings, range));
+  EXPECT_EQ(range_strings[0], "2");
+  EXPECT_EQ(range_strings[2], "4");
+
+  // Too few elements in the received value
+  ext_value = CreateExtendedValue(true, sup::dto::AnyValue{slice_type}, 0, 0);
+  result = channel_access_helper::ExtractElementRange(ext_value, range);
+  EXPECT_TRUE(sup::dto::IsEmptyValue(result.value));
+}
+
+ChannelAccessHelperTest::ChannelAccessHelperTest() = default;
+ChannelAccessHelperTest::~ChannelAccessHelperTest() = default;
+
+sup::epics::ChannelAccessPV::ExtendedValue ChannelAccessHelperTest::CreateExtendedValue(
+  bool connected, const sup::dto::AnyValue& value, sup::dto::int16 status,
+  sup::dto::int16 severity)
+{
+  sup::epics::ChannelAccessPV::ExtendedValue result;
+  result.connected = connected;
+  result.value = value;
+  result.status = status;
+  result.severity = severity;
+  return result;
+}
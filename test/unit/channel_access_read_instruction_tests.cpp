@@ -23,6 +23,8 @@
 #include "test_user_interface.h"
 #include "unit_test_helper.h"
 
+#include <oac-tree/common/plugin_diagnostics.h>
+
 #include <sup/oac-tree/exceptions.h>
 #include <sup/oac-tree/instruction.h>
 #include <sup/oac-tree/instruction_registry.h>
@@ -419,6 +421,106 @@ TEST_F(ChannelAccessReadInstructionTest, ReadBoolean)
   EXPECT_TRUE(string_var == "TRUE");
 }
 
+TEST_F(ChannelAccessReadInstructionTest, ReadElementRange)
+{
+  DefaultUserInterface ui;
+  const std::string procedure_body{
+R"RAW(
+  <Sequence>
+    <ChannelAccessWrite channel="SEQ-TEST:UIARRAY" varName="full"/>
+    <ChannelAccessRead channel="SEQ-TEST:UIARRAY" outputVar="slice" offset="2" count="3"/>
+    <Equal leftVar="slice" rightVar="expected"/>
+  </Sequence>
+  <Workspace>
+    <Local name="full" type='{"type":"uint32[]","multiplicity":8,"element":{"type":"uint32"}}'
+           value="[1, 2, 3, 4, 5, 6, 7, 8]"/>
+    <Local name="slice" type='{"type":"uint32[]","multiplicity":3,"element":{"type":"uint32"}}'/>
+    <Local name="expected" type='{"type":"uint32[]","multiplicity":3,"element":{"type":"uint32"}}'
+           value="[3, 4, 5]"/>
+  </Workspace>
+)RAW"};
+
+  const auto procedure_string = unit_test_helper::CreateProcedureString(procedure_body);
+  auto proc = ParseProcedureString(procedure_string);
+  EXPECT_TRUE(unit_test_helper::TryAndExecute(proc, ui));
+}
+
+TEST_F(ChannelAccessReadInstructionTest, ReadElementRangeWrongType)
+{
+  DefaultUserInterface ui;
+  const std::string procedure_body{
+R"RAW(
+  <ChannelAccessRead channel="SEQ-TEST:UIARRAY" outputVar="slice" offset="2" count="4"/>
+  <Workspace>
+    <Local name="slice" type='{"type":"uint32[]","multiplicity":3,"element":{"type":"uint32"}}'/>
+  </Workspace>
+)RAW"};
+
+  const auto procedure_string = unit_test_helper::CreateProcedureString(procedure_body);
+  auto proc = ParseProcedureString(procedure_string);
+  EXPECT_TRUE(unit_test_helper::TryAndExecute(proc, ui, ExecutionStatus::FAILURE));
+}
+
+TEST_F(ChannelAccessReadInstructionTest, ReadFromMonitor)
+{
+  // Value is taken from the client variable that monitors the same channel
+  DefaultUserInterface ui;
+  const std::string procedure_body{
+R"RAW(
+  <Sequence>
+    <WaitForVariable varName="monitor" timeout="5.0"/>
+    <ChannelAccessRead channel="SEQ-TEST:BOOL" outputVar="myvar" maxAge="3600.0"/>
+    <Equals leftVar="monitor" rightVar="myvar"/>
+  </Sequence>
+  <Workspace>
+    <ChannelAccessClient name="monitor" channel="SEQ-TEST:BOOL" type='{"type":"bool"}'/>
+    <Local name="myvar" type='{"type":"bool"}'/>
+  </Workspace>
+)RAW"};
+
+  const auto procedure_string = unit_test_helper::CreateProcedureString(procedure_body);
+  auto proc = ParseProcedureString(procedure_string);
+  EXPECT_TRUE(unit_test_helper::TryAndExecute(proc, ui));
+}
+
+TEST_F(ChannelAccessReadInstructionTest, RepeatedReadLiteralChannel)
+{
+  // Channel is created during setup and used by the first iteration: Repeat resets its child,
+  // which releases the channel
+  DefaultUserInterface ui;
+  const std::string procedure_body{
+R"RAW(
+  <Repeat maxCount="3">
+    <ChannelAccessRead channel="SEQ-TEST:BOOL" outputVar="myvar" timeout="5.0"/>
+  </Repeat>
+  <Workspace>
+    <Local name="myvar" type='{"type":"bool"}'/>
+  </Workspace>
+)RAW"};
+
+  const auto procedure_string = unit_test_helper::CreateProcedureString(procedure_body);
+  auto proc = ParseProcedureString(procedure_string);
+  auto prefetched_before = epics_helper::CollectPluginDiagnostics().prefetched_channels;
+  EXPECT_TRUE(unit_test_helper::TryAndExecute(proc, ui));
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().prefetched_channels, prefetched_before + 1);
+}
+
+TEST_F(ChannelAccessReadInstructionTest, NegativeMaxAge)
+{
+  DefaultUserInterface ui;
+  const std::string procedure_body{
+R"RAW(
+  <ChannelAccessRead channel="SEQ-TEST:BOOL" outputVar="myvar" maxAge="-1.0"/>
+  <Workspace>
+    <Local name="myvar" type='{"type":"bool"}'/>
+  </Workspace>
+)RAW"};
+
+  const auto procedure_string = unit_test_helper::CreateProcedureString(procedure_body);
+  auto proc = ParseProcedureString(procedure_string);
+  EXPECT_TRUE(unit_test_helper::TryAndExecute(proc, ui, ExecutionStatus::FAILURE));
+}
+
 TEST_F(ChannelAccessReadInstructionTest, VariableAttributes)
 {
   DefaultUserInterface ui;
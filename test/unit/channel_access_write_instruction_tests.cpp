@@ -23,6 +23,8 @@
 #include "test_user_interface.h"
 #include "unit_test_helper.h"
 
+#include <oac-tree/common/plugin_diagnostics.h>
+
 #include <sup/oac-tree/exceptions.h>
 #include <sup/oac-tree/instruction.h>
 #include <sup/oac-tree/instruction_registry.h>
@@ -258,6 +260,60 @@ TEST_F(ChannelAccessWriteInstructionTest, WriteSuccess)
   // }));
 }
 
+TEST_F(ChannelAccessWriteInstructionTest, WriteOnlyIfChanged)
+{
+  unit_test_helper::NullUserInterface ui;
+  Procedure proc;
+
+  Workspace ws;
+  // Variable that monitors the channel
+  auto variable = GlobalVariableRegistry().Create("ChannelAccessClient");
+  ASSERT_TRUE(static_cast<bool>(variable));
+  EXPECT_TRUE(variable->AddAttribute("channel", "SEQ-TEST:BOOL"));
+  EXPECT_TRUE(variable->AddAttribute("type", BOOLEANTYPE));
+  EXPECT_TRUE(ws.AddVariable("var", std::move(variable)));
+  EXPECT_NO_THROW(ws.Setup());
+  EXPECT_TRUE(ws.WaitForVariable("var", 5.0));
+
+  auto write_instruction = GlobalInstructionRegistry().Create("ChannelAccessWrite");
+  ASSERT_TRUE(static_cast<bool>(write_instruction));
+  EXPECT_TRUE(write_instruction->AddAttribute("channel", "SEQ-TEST:BOOL"));
+  EXPECT_TRUE(write_instruction->AddAttribute("type", BOOLEANTYPE));
+  EXPECT_TRUE(write_instruction->AddAttribute("value", "true"));
+  EXPECT_TRUE(write_instruction->AddAttribute("timeout", "5.0"));
+  EXPECT_TRUE(write_instruction->AddAttribute("onlyIfChanged", "true"));
+  auto execute = [&]() {
+    EXPECT_NO_THROW(write_instruction->Setup(proc));
+    while (!IsFinishedStatus(write_instruction->GetStatus()))
+    {
+      EXPECT_NO_THROW(write_instruction->ExecuteSingle(ui, ws));
+    }
+    EXPECT_EQ(write_instruction->GetStatus(), ExecutionStatus::SUCCESS);
+    EXPECT_NO_THROW(write_instruction->Reset(ui));
+  };
+  auto skipped_before = epics_helper::CollectPluginDiagnostics().skipped_writes;
+  execute();
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(2.0, [&ws]{
+    sup::dto::AnyValue tmp;
+    return ws.GetValue("var", tmp) && tmp.As<bool>();
+  }));
+  auto skipped_after_first = epics_helper::CollectPluginDiagnostics().skipped_writes;
+  EXPECT_LE(skipped_after_first, skipped_before + 1);
+
+  // Writing the same value again is skipped
+  execute();
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().skipped_writes, skipped_after_first + 1);
+
+  // A different value is written
+  EXPECT_TRUE(write_instruction->SetAttribute("value", "false"));
+  execute();
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().skipped_writes, skipped_after_first + 1);
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(2.0, [&ws]{
+    sup::dto::AnyValue tmp;
+    return ws.GetValue("var", tmp) && !tmp.As<bool>();
+  }));
+}
+
 TEST_F(ChannelAccessWriteInstructionTest, WriteSuccessStruct)
 {
   unit_test_helper::NullUserInterface ui;
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+#include <oac-tree/common/connection_scheduler.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace sup::oac_tree;
+
+class ConnectionSchedulerTest : public ::testing::Test
+{
+protected:
+  ConnectionSchedulerTest();
+  ~ConnectionSchedulerTest();
+
+  std::function<void()> RecordingConnect(int id);
+  std::vector<int> GetConnected() const;
+  static bool WaitFor(const std::function<bool()>& condition);
+
+  mutable std::mutex m_mtx;
+  std::vector<int> m_connected;
+};
+
+TEST_F(ConnectionSchedulerTest, ParseConnectPriority)
+{
+  sup::dto::int32 priority = 0;
+  EXPECT_TRUE(epics_helper::ParseConnectPriority("5", priority));
+  EXPECT_EQ(priority, 5);
+  EXPECT_TRUE(epics_helper::ParseConnectPriority("-3", priority));
+  EXPECT_EQ(priority, -3);
+  EXPECT_FALSE(epics_helper::ParseConnectPriority("", priority));
+  EXPECT_FALSE(epics_helper::ParseConnectPriority("high", priority));
+  EXPECT_FALSE(epics_helper::ParseConnectPriority("1.5", priority));
+  EXPECT_FALSE(epics_helper::ParseConnectPriority("99999999999", priority));
+}
+
+TEST_F(ConnectionSchedulerTest, Unthrottled)
+{
+  epics_helper::ConnectionScheduler scheduler;
+  EXPECT_EQ(scheduler.GetSearchRate(), 0.0);
+  EXPECT_LT(scheduler.GetSnapshot().time_to_all_connected, 0.0);
+  EXPECT_LT(scheduler.GetSnapshot().pending_since, 0.0);
+  auto first = std::make_shared<epics_helper::ScheduledConnection>(0);
+  auto second = std::make_shared<epics_helper::ScheduledConnection>(0);
+  scheduler.Schedule(first, RecordingConnect(1));
+  scheduler.Schedule(second, RecordingConnect(2));
+  // Channels are created immediately
+  EXPECT_EQ(GetConnected(), std::vector<int>({1, 2}));
+  auto snapshot = scheduler.GetSnapshot();
+  EXPECT_EQ(snapshot.scheduled, 2);
+  EXPECT_EQ(snapshot.queued, 0);
+  EXPECT_EQ(snapshot.pending, 2);
+  EXPECT_LT(snapshot.time_to_all_connected, 0.0);
+  EXPECT_GE(snapshot.pending_since, 0.0);
+  first->MarkConnected();
+  first->MarkConnected();
+  EXPECT_EQ(scheduler.GetSnapshot().pending, 1);
+  // A channel that does not connect keeps the pending time growing
+  auto pending_since = scheduler.GetSnapshot().pending_since;
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_GE(scheduler.GetSnapshot().pending_since, pending_since + 0.015);
+  second->MarkConnected();
+  snapshot = scheduler.GetSnapshot();
+  EXPECT_EQ(snapshot.pending, 0);
+  EXPECT_GE(snapshot.time_to_all_connected, 0.02);
+  EXPECT_LT(snapshot.pending_since, 0.0);
+}
+
+TEST_F(ConnectionSchedulerTest, ThrottledPriorityOrder)
+{
+  epics_helper::ConnectionScheduler scheduler{100.0};
+  std::vector<std::shared_ptr<epics_helper::ScheduledConnection>> connections;
+  const std::vector<sup::dto::int32> priorities{0, 0, 5, 1, 5};
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < priorities.size(); ++i)
+  {
+    connections.push_back(std::make_shared<epics_helper::ScheduledConnection>(priorities[i]));
+    scheduler.Schedule(connections.back(), RecordingConnect(static_cast<int>(i)));
+  }
+  EXPECT_TRUE(WaitFor([this]() { return GetConnected().size() == 5; }));
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  // Four intervals of 10 ms after the first search
+  EXPECT_GE(elapsed.count(), 0.035);
+  // The first connection may already have started before the others were scheduled
+  auto connected = GetConnected();
+  if (connected.front() == 0)
+  {
+    EXPECT_EQ(connected, std::vector<int>({0, 2, 4, 3, 1}));
+  }
+  else
+  {
+    EXPECT_EQ(connected, std::vector<int>({2, 4, 3, 0, 1}));
+  }
+  EXPECT_EQ(scheduler.GetSnapshot().queued, 0);
+  EXPECT_EQ(scheduler.GetSnapshot().pending, 5);
+}
+
+TEST_F(ConnectionSchedulerTest, Cancel)
+{
+  epics_helper::ConnectionScheduler scheduler{2.0};
+  auto first = std::make_shared<epics_helper::ScheduledConnection>(0);
+  auto second = std::make_shared<epics_helper::ScheduledConnection>(0);
+  auto third = std::make_shared<epics_helper::ScheduledConnection>(0);
+  scheduler.Schedule(first, RecordingConnect(1));
+  EXPECT_TRUE(WaitFor([this]() { return GetConnected().size() == 1; }));
+  // Next slot is half a second later
+  scheduler.Schedule(second, RecordingConnect(2));
+  scheduler.Schedule(third, RecordingConnect(3));
+  EXPECT_EQ(scheduler.GetSnapshot().queued, 2);
+  scheduler.Cancel(*second);
+  // Expired connections are skipped as well
+  third.reset();
+  auto snapshot = scheduler.GetSnapshot();
+  EXPECT_EQ(snapshot.queued, 0);
+  EXPECT_EQ(snapshot.pending, 1);
+  first->MarkConnected();
+  EXPECT_EQ(scheduler.GetSnapshot().pending, 0);
+  EXPECT_GE(scheduler.GetSnapshot().time_to_all_connected, 0.0);
+  scheduler.SetSearchRate(0.0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(GetConnected(), std::vector<int>({1}));
+  EXPECT_EQ(scheduler.GetSnapshot().queued, 0);
+}
+
+ConnectionSchedulerTest::ConnectionSchedulerTest()
+  : m_mtx{}
+  , m_connected{}
+{}
+
+ConnectionSchedulerTest::~ConnectionSchedulerTest() = default;
+
+std::function<void()> ConnectionSchedulerTest::RecordingConnect(int id)
+{
+  return [this, id]() {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_connected.push_back(id);
+  };
+}
+
+std::vector<int> ConnectionSchedulerTest::GetConnected() const
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  return m_connected;
+}
+
+bool ConnectionSchedulerTest::WaitFor(const std::function<bool()>& condition)
+{
+  for (int i = 0; i < 200; ++i)
+  {
+    if (condition())
+    {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return condition();
+}
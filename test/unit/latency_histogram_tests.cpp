@@ -0,0 +1,151 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+#include <oac-tree/common/latency_histogram.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace sup::oac_tree;
+
+using LatencyPtr = std::shared_ptr<const epics_helper::ChannelLatency>;
+
+class LatencyHistogramTest : public ::testing::Test
+{
+protected:
+  LatencyHistogramTest();
+  ~LatencyHistogramTest();
+};
+
+TEST_F(LatencyHistogramTest, Buckets)
+{
+  using epics_helper::LatencyHistogram;
+  // Small values have their own bucket
+  for (sup::dto::uint64 value = 0; value < 2 * LatencyHistogram::LATENCY_SUB_BUCKETS; ++value)
+  {
+    EXPECT_EQ(LatencyHistogram::BucketUpperBound(LatencyHistogram::BucketIndex(value)), value);
+  }
+  // Every value lies in its bucket and buckets are contiguous
+  for (sup::dto::uint64 value = 1; value < (sup::dto::uint64{1} << 36); value = value * 3 + 1)
+  {
+    auto idx = LatencyHistogram::BucketIndex(value);
+    ASSERT_LT(idx, LatencyHistogram::LATENCY_BUCKETS);
+    auto upper = LatencyHistogram::BucketUpperBound(idx);
+    auto lower = LatencyHistogram::BucketUpperBound(idx - 1) + 1;
+    EXPECT_LE(value, upper);
+    EXPECT_GE(value, lower);
+    // Relative resolution
+    EXPECT_LE(upper - lower, lower / LatencyHistogram::LATENCY_SUB_BUCKETS);
+  }
+  // Very large values end up in the last bucket
+  EXPECT_EQ(LatencyHistogram::BucketIndex(~sup::dto::uint64{0}),
+            LatencyHistogram::LATENCY_BUCKETS - 1);
+}
+
+TEST_F(LatencyHistogramTest, Percentiles)
+{
+  epics_helper::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.GetCount(), 0);
+  EXPECT_EQ(histogram.GetValueAtPercentile(50.0), 0);
+  EXPECT_TRUE(histogram.GetBuckets().empty());
+
+  // 1..1000 microseconds
+  for (sup::dto::uint64 i = 1; i <= 1000; ++i)
+  {
+    histogram.Record(i * 1000);
+  }
+  EXPECT_EQ(histogram.GetCount(), 1000);
+  EXPECT_EQ(histogram.GetMax(), 1000000);
+  auto p50 = histogram.GetValueAtPercentile(50.0);
+  EXPECT_GE(p50, 500000);
+  EXPECT_LE(p50, 500000 + 500000 / 16);
+  auto p99 = histogram.GetValueAtPercentile(99.0);
+  EXPECT_GE(p99, 990000);
+  EXPECT_LE(p99, 1000000);
+  EXPECT_EQ(histogram.GetValueAtPercentile(100.0), 1000000);
+
+  sup::dto::uint64 total = 0;
+  for (const auto& bucket : histogram.GetBuckets())
+  {
+    total += bucket.second;
+  }
+  EXPECT_EQ(total, 1000);
+}
+
+TEST_F(LatencyHistogramTest, ChannelLatency)
+{
+  epics_helper::ChannelLatency latency{"TestVariable", "test::channel"};
+  EXPECT_EQ(latency.GetVariableType(), "TestVariable");
+  EXPECT_EQ(latency.GetChannel(), "test::channel");
+  latency.RecordUpdate(1000, 3000, 3500);
+  EXPECT_EQ(latency.GetSourceLatency().GetMax(), 2000);
+  EXPECT_EQ(latency.GetProcessingLatency().GetMax(), 500);
+  // Without source timestamp, only the processing latency is recorded
+  latency.RecordUpdate(0, 3000, 3100);
+  EXPECT_EQ(latency.GetSourceLatency().GetCount(), 1);
+  EXPECT_EQ(latency.GetProcessingLatency().GetCount(), 2);
+  // Source timestamp in the future
+  latency.RecordUpdate(5000, 3000, 3100);
+  EXPECT_EQ(latency.GetClockSkewCount(), 1);
+  EXPECT_EQ(latency.GetSourceLatency().GetCount(), 2);
+}
+
+TEST_F(LatencyHistogramTest, RegistryAndFile)
+{
+  auto latency = epics_helper::CreateChannelLatency("TestVariable", "latency-test::channel");
+  auto latencies = epics_helper::GetChannelLatencies();
+  EXPECT_TRUE(std::any_of(latencies.begin(), latencies.end(), [&latency](const LatencyPtr& entry) {
+    return entry.get() == latency.get();
+  }));
+  latency->RecordUpdate(1000, 3000, 3500);
+
+  const std::string filename = "latency_histogram_test.jsonl";
+  (void)std::remove(filename.c_str());
+  EXPECT_TRUE(epics_helper::AppendChannelLatency(*latency, filename));
+  EXPECT_TRUE(epics_helper::AppendChannelLatency(*latency, filename));
+  std::ifstream file{filename};
+  std::string line;
+  int n_lines = 0;
+  while (std::getline(file, line))
+  {
+    ++n_lines;
+    EXPECT_NE(line.find(R"("channel":"latency-test::channel")"), std::string::npos);
+    EXPECT_NE(line.find(R"("source":{"count":1)"), std::string::npos);
+  }
+  EXPECT_EQ(n_lines, 2);
+  (void)std::remove(filename.c_str());
+
+  auto raw_latency = latency.get();
+  latencies.clear();
+  latency.reset();
+  latencies = epics_helper::GetChannelLatencies();
+  EXPECT_TRUE(std::none_of(latencies.begin(), latencies.end(),
+                           [raw_latency](const LatencyPtr& entry) {
+                             return entry.get() == raw_latency;
+                           }));
+}
+
+LatencyHistogramTest::LatencyHistogramTest() = default;
+LatencyHistogramTest::~LatencyHistogramTest() = default;
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+#include <oac-tree/common/lazy_channel.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace sup::oac_tree;
+
+class LazyChannelTest : public ::testing::Test
+{
+protected:
+  LazyChannelTest();
+  ~LazyChannelTest();
+
+  struct TestPV
+  {
+    bool WaitForConnected(double timeout_sec) const
+    {
+      (void)timeout_sec;
+      ++waits;
+      return true;
+    }
+
+    std::string channel;
+    mutable int waits = 0;
+  };
+
+  epics_helper::LazyChannel<TestPV>::Factory CountingFactory(const std::string& channel);
+
+  int m_created;
+};
+
+TEST_F(LazyChannelTest, ParseConnectMode)
+{
+  bool lazy = true;
+  EXPECT_TRUE(epics_helper::ParseConnectMode("eager", lazy));
+  EXPECT_FALSE(lazy);
+  EXPECT_TRUE(epics_helper::ParseConnectMode("lazy", lazy));
+  EXPECT_TRUE(lazy);
+  EXPECT_FALSE(epics_helper::ParseConnectMode("", lazy));
+  EXPECT_FALSE(epics_helper::ParseConnectMode("Lazy", lazy));
+}
+
+TEST_F(LazyChannelTest, Eager)
+{
+  epics_helper::LazyChannel<TestPV> channel;
+  EXPECT_EQ(channel.Get(), nullptr);
+  channel.Create(CountingFactory("chan"), false);
+  EXPECT_EQ(m_created, 1);
+  EXPECT_FALSE(channel.IsPending());
+  ASSERT_NE(channel.Get(), nullptr);
+  EXPECT_EQ(channel.Get()->channel, "chan");
+  channel.Reset();
+  EXPECT_EQ(channel.Get(), nullptr);
+}
+
+TEST_F(LazyChannelTest, Lazy)
+{
+  epics_helper::LazyChannel<TestPV> channel;
+  channel.Create(CountingFactory("chan"), true);
+  EXPECT_EQ(m_created, 0);
+  EXPECT_TRUE(channel.IsPending());
+  ASSERT_NE(channel.Get(), nullptr);
+  EXPECT_EQ(m_created, 1);
+  EXPECT_FALSE(channel.IsPending());
+  // Channel is only created once
+  EXPECT_EQ(channel.Get()->channel, "chan");
+  EXPECT_EQ(m_created, 1);
+  // Reset drops a pending creation
+  channel.Create(CountingFactory("other"), true);
+  channel.Reset();
+  EXPECT_FALSE(channel.IsPending());
+  EXPECT_EQ(channel.Get(), nullptr);
+  EXPECT_EQ(m_created, 1);
+}
+
+TEST_F(LazyChannelTest, GetConnected)
+{
+  epics_helper::LazyChannel<TestPV> channel;
+  channel.Create(CountingFactory("chan"), true);
+  // Only the access that creates the channel waits for its connection
+  auto pv = channel.GetConnected(1.0);
+  ASSERT_NE(pv, nullptr);
+  EXPECT_EQ(m_created, 1);
+  EXPECT_EQ(pv->waits, 1);
+  EXPECT_EQ(channel.GetConnected(1.0), pv);
+  EXPECT_EQ(pv->waits, 1);
+
+  // Channels created eagerly or through Get are not waited for
+  channel.Create(CountingFactory("eager"), false);
+  ASSERT_NE(channel.GetConnected(1.0), nullptr);
+  EXPECT_EQ(channel.Get()->waits, 0);
+  channel.Create(CountingFactory("scheduled"), true);
+  ASSERT_NE(channel.Get(), nullptr);
+  EXPECT_EQ(channel.GetConnected(1.0)->waits, 0);
+}
+
+TEST_F(LazyChannelTest, ConcurrentFirstAccess)
+{
+  epics_helper::LazyChannel<TestPV> channel;
+  channel.Create(CountingFactory("chan"), true);
+  std::vector<std::thread> threads;
+  std::vector<TestPV*> results(8, nullptr);
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    threads.emplace_back([&channel, &results, i]() { results[i] = channel.Get(); });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(m_created, 1);
+  for (auto result : results)
+  {
+    EXPECT_EQ(result, channel.Get());
+  }
+}
+
+LazyChannelTest::LazyChannelTest()
+  : m_created{0}
+{}
+
+LazyChannelTest::~LazyChannelTest() = default;
+
+epics_helper::LazyChannel<LazyChannelTest::TestPV>::Factory LazyChannelTest::CountingFactory(
+  const std::string& channel)
+{
+  return [this, channel]() {
+    ++m_created;
+    return std::make_unique<TestPV>(TestPV{channel});
+  };
+}
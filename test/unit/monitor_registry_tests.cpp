@@ -0,0 +1,110 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+#include <oac-tree/common/monitor_registry.h>
+
+#include <gtest/gtest.h>
+
+using namespace sup::oac_tree;
+
+class MonitorRegistryTest : public ::testing::Test
+{
+protected:
+  MonitorRegistryTest();
+  ~MonitorRegistryTest();
+
+  using TestMonitor = epics_helper::MonitoredChannel<int>;
+};
+
+TEST_F(MonitorRegistryTest, MonitoredChannel)
+{
+  int source = 5;
+  TestMonitor monitor{[&source]() { return source; }};
+  int value = 0;
+  // No update received yet
+  EXPECT_FALSE(monitor.GetValue(1000, 2000, value));
+  monitor.SetLastUpdate(1500);
+  EXPECT_TRUE(monitor.GetValue(1000, 2000, value));
+  EXPECT_EQ(value, 5);
+  EXPECT_TRUE(monitor.GetValue(500, 2000, value));
+  EXPECT_FALSE(monitor.GetValue(499, 2000, value));
+  // Update received after the requested time
+  source = 6;
+  EXPECT_TRUE(monitor.GetValue(0, 1000, value));
+  EXPECT_EQ(value, 6);
+  // Disconnected
+  monitor.SetLastUpdate(0);
+  EXPECT_FALSE(monitor.GetValue(1000, 2000, value));
+  // Closed
+  monitor.SetLastUpdate(1500);
+  monitor.Close();
+  EXPECT_FALSE(monitor.GetValue(1000, 2000, value));
+  EXPECT_EQ(value, 6);
+}
+
+TEST_F(MonitorRegistryTest, ChannelAndType)
+{
+  epics_helper::MonitorRegistry<int> registry;
+  auto monitor = std::make_shared<TestMonitor>([]() { return 1; });
+  monitor->SetLastUpdate(1000);
+  registry.Register("chan", sup::dto::UnsignedInteger32Type, monitor);
+  EXPECT_EQ(registry.GetSize(), 1u);
+  int value = 0;
+  EXPECT_TRUE(registry.GetValue("chan", sup::dto::UnsignedInteger32Type, 100, 1050, value));
+  EXPECT_EQ(value, 1);
+  EXPECT_FALSE(registry.GetValue("other", sup::dto::UnsignedInteger32Type, 100, 1050, value));
+  EXPECT_FALSE(registry.GetValue("chan", sup::dto::Float64Type, 100, 1050, value));
+  EXPECT_FALSE(registry.GetValue("chan", sup::dto::UnsignedInteger32Type, 10, 1050, value));
+}
+
+TEST_F(MonitorRegistryTest, MultipleMonitors)
+{
+  epics_helper::MonitorRegistry<int> registry;
+  auto old_monitor = std::make_shared<TestMonitor>([]() { return 1; });
+  old_monitor->SetLastUpdate(100);
+  registry.Register("chan", sup::dto::EmptyType, old_monitor);
+  auto recent_monitor = std::make_shared<TestMonitor>([]() { return 2; });
+  recent_monitor->SetLastUpdate(1000);
+  registry.Register("chan", sup::dto::EmptyType, recent_monitor);
+  EXPECT_EQ(registry.GetSize(), 2u);
+  int value = 0;
+  EXPECT_TRUE(registry.GetValue("chan", sup::dto::EmptyType, 100, 1050, value));
+  EXPECT_EQ(value, 2);
+}
+
+TEST_F(MonitorRegistryTest, ReleasedMonitor)
+{
+  epics_helper::MonitorRegistry<int> registry;
+  auto monitor = std::make_shared<TestMonitor>([]() { return 1; });
+  monitor->SetLastUpdate(1000);
+  registry.Register("chan", sup::dto::EmptyType, monitor);
+  monitor.reset();
+  EXPECT_EQ(registry.GetSize(), 0u);
+  int value = 0;
+  EXPECT_FALSE(registry.GetValue("chan", sup::dto::EmptyType, 100, 1050, value));
+  // Released monitors are removed on the next registration
+  auto other = std::make_shared<TestMonitor>([]() { return 2; });
+  registry.Register("other", sup::dto::EmptyType, other);
+  EXPECT_EQ(registry.GetSize(), 1u);
+}
+
+MonitorRegistryTest::MonitorRegistryTest() = default;
+MonitorRegistryTest::~MonitorRegistryTest() = default;
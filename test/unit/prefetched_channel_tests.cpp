@@ -0,0 +1,119 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/plugin_diagnostics.h>
+#include <oac-tree/common/prefetched_channel.h>
+
+#include <gtest/gtest.h>
+
+using namespace sup::oac_tree;
+
+class PrefetchedChannelTest : public ::testing::Test
+{
+protected:
+  PrefetchedChannelTest();
+  ~PrefetchedChannelTest();
+
+  struct TestPV
+  {
+    std::string channel;
+  };
+};
+
+TEST_F(PrefetchedChannelTest, IsVariableReference)
+{
+  EXPECT_TRUE(epics_helper::IsVariableReference("@chan"));
+  EXPECT_TRUE(epics_helper::IsVariableReference("@"));
+  EXPECT_FALSE(epics_helper::IsVariableReference(""));
+  EXPECT_FALSE(epics_helper::IsVariableReference("EPICS::CA::CHANNEL"));
+  EXPECT_FALSE(epics_helper::IsVariableReference("CHANNEL@HOST"));
+}
+
+TEST_F(PrefetchedChannelTest, Disabled)
+{
+  epics_helper::PrefetchedChannel<TestPV> prefetched;
+  EXPECT_FALSE(prefetched.IsEnabled());
+  prefetched.Store("chan", sup::dto::EmptyType, std::make_unique<TestPV>(TestPV{"chan"}));
+  EXPECT_EQ(prefetched.Take("chan", sup::dto::EmptyType), nullptr);
+}
+
+TEST_F(PrefetchedChannelTest, StoreAndTake)
+{
+  epics_helper::PrefetchedChannel<TestPV> prefetched;
+  prefetched.SetEnabled(true);
+  EXPECT_TRUE(prefetched.IsEnabled());
+  auto prefetched_before = epics_helper::CollectPluginDiagnostics().prefetched_channels;
+  prefetched.Store("chan", sup::dto::UnsignedInteger32Type,
+                   std::make_unique<TestPV>(TestPV{"chan"}));
+  auto pv = prefetched.Take("chan", sup::dto::UnsignedInteger32Type);
+  ASSERT_NE(pv, nullptr);
+  EXPECT_EQ(pv->channel, "chan");
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().prefetched_channels, prefetched_before + 1);
+  // Channel can only be taken once
+  EXPECT_EQ(prefetched.Take("chan", sup::dto::UnsignedInteger32Type), nullptr);
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().prefetched_channels, prefetched_before + 1);
+  // Store again for the next execution
+  prefetched.Store("chan", sup::dto::UnsignedInteger32Type, std::move(pv));
+  EXPECT_NE(prefetched.Take("chan", sup::dto::UnsignedInteger32Type), nullptr);
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().prefetched_channels, prefetched_before + 2);
+}
+
+TEST_F(PrefetchedChannelTest, Mismatch)
+{
+  epics_helper::PrefetchedChannel<TestPV> prefetched;
+  prefetched.SetEnabled(true);
+  // Different channel name
+  prefetched.Store("chan", sup::dto::EmptyType, std::make_unique<TestPV>(TestPV{"chan"}));
+  EXPECT_EQ(prefetched.Take("other", sup::dto::EmptyType), nullptr);
+  // The mismatching channel was discarded
+  EXPECT_EQ(prefetched.Take("chan", sup::dto::EmptyType), nullptr);
+  // Different channel type
+  prefetched.Store("chan", sup::dto::UnsignedInteger32Type,
+                   std::make_unique<TestPV>(TestPV{"chan"}));
+  EXPECT_EQ(prefetched.Take("chan", sup::dto::Float64Type), nullptr);
+}
+
+TEST_F(PrefetchedChannelTest, DisableDiscards)
+{
+  epics_helper::PrefetchedChannel<TestPV> prefetched;
+  prefetched.SetEnabled(true);
+  prefetched.Store("chan", sup::dto::EmptyType, std::make_unique<TestPV>(TestPV{"chan"}));
+  prefetched.SetEnabled(false);
+  prefetched.SetEnabled(true);
+  EXPECT_EQ(prefetched.Take("chan", sup::dto::EmptyType), nullptr);
+}
+
+TEST_F(PrefetchedChannelTest, ClearKeepsEnabled)
+{
+  epics_helper::PrefetchedChannel<TestPV> prefetched;
+  prefetched.SetEnabled(true);
+  prefetched.Store("chan", sup::dto::EmptyType, std::make_unique<TestPV>(TestPV{"chan"}));
+  prefetched.Clear();
+  EXPECT_TRUE(prefetched.IsEnabled());
+  EXPECT_EQ(prefetched.Take("chan", sup::dto::EmptyType), nullptr);
+  // Channels can still be stored after clearing
+  prefetched.Store("chan", sup::dto::EmptyType, std::make_unique<TestPV>(TestPV{"chan"}));
+  EXPECT_NE(prefetched.Take("chan", sup::dto::EmptyType), nullptr);
+}
+
+PrefetchedChannelTest::PrefetchedChannelTest() = default;
+PrefetchedChannelTest::~PrefetchedChannelTest() = default;
@@ -23,6 +23,9 @@
 #include <oac-tree/pvxs/pv_access_client_variable.h>
 #include "unit_test_helper.h"
 
+#include <oac-tree/common/epics_helper.h>
+#include <oac-tree/common/variable_statistics.h>
+
 #include <sup/oac-tree/exceptions.h>
 #include <sup/oac-tree/sequence_parser.h>
 #include <sup/oac-tree/user_interface.h>
@@ -36,6 +39,7 @@
 #include <sup/epics-test/unit_test_helper.h>
 
 #include <algorithm>
+#include <memory>
 
 using namespace sup::oac_tree;
 
@@ -90,6 +94,103 @@ TEST_F(PvAccessClientVariableTest, Setup)
     EXPECT_NO_THROW(variable.Setup(ws));
     EXPECT_NO_THROW(variable.Teardown());
   }
+  // connect attribute should be eager or lazy
+  {
+    PvAccessClientVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "Not_Relevant"));
+    EXPECT_TRUE(variable.AddAttribute("connect", "sometimes"));
+    EXPECT_THROW(variable.Setup(ws), VariableSetupException);
+  }
+  {
+    PvAccessClientVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "Not_Relevant"));
+    EXPECT_TRUE(variable.AddAttribute("connect", "lazy"));
+    EXPECT_NO_THROW(variable.Setup(ws));
+    EXPECT_NO_THROW(variable.Teardown());
+  }
+  // connectPriority attribute should be an integer
+  {
+    PvAccessClientVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "Not_Relevant"));
+    EXPECT_TRUE(variable.AddAttribute("connectPriority", "high"));
+    EXPECT_THROW(variable.Setup(ws), VariableSetupException);
+  }
+  {
+    PvAccessClientVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "Not_Relevant"));
+    EXPECT_TRUE(variable.AddAttribute("connectPriority", "-2"));
+    EXPECT_NO_THROW(variable.Setup(ws));
+    EXPECT_NO_THROW(variable.Teardown());
+  }
+  // mode attribute should be monitor or connection
+  {
+    PvAccessClientVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "Not_Relevant"));
+    EXPECT_TRUE(variable.AddAttribute("mode", "value"));
+    EXPECT_THROW(variable.Setup(ws), VariableSetupException);
+  }
+  {
+    PvAccessClientVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "Not_Relevant"));
+    EXPECT_TRUE(variable.AddAttribute("mode", "connection"));
+    EXPECT_NO_THROW(variable.Setup(ws));
+    EXPECT_NO_THROW(variable.Teardown());
+  }
+  // maxAge and timeout attributes should be non-negative numbers
+  {
+    PvAccessClientVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "Not_Relevant"));
+    EXPECT_TRUE(variable.AddAttribute("mode", "get"));
+    EXPECT_TRUE(variable.AddAttribute("maxAge", "-1"));
+    EXPECT_THROW(variable.Setup(ws), VariableSetupException);
+  }
+  {
+    PvAccessClientVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "Not_Relevant"));
+    EXPECT_TRUE(variable.AddAttribute("mode", "get"));
+    EXPECT_TRUE(variable.AddAttribute("timeout", "soon"));
+    EXPECT_THROW(variable.Setup(ws), VariableSetupException);
+  }
+  {
+    PvAccessClientVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "Not_Relevant"));
+    EXPECT_TRUE(variable.AddAttribute("mode", "get"));
+    EXPECT_TRUE(variable.AddAttribute("maxAge", "2.5"));
+    EXPECT_TRUE(variable.AddAttribute("timeout", "0.1"));
+    EXPECT_NO_THROW(variable.Setup(ws));
+    sup::dto::AnyValue value;
+    EXPECT_FALSE(variable.GetValue(value));
+    EXPECT_NO_THROW(variable.Teardown());
+  }
+}
+
+TEST_F(PvAccessClientVariableTest, ParseClientMode)
+{
+  epics_helper::ClientMode mode = epics_helper::ClientMode::kConnection;
+  EXPECT_TRUE(epics_helper::ParseClientMode("monitor", mode));
+  EXPECT_EQ(mode, epics_helper::ClientMode::kMonitor);
+  EXPECT_TRUE(epics_helper::ParseClientMode("connection", mode));
+  EXPECT_EQ(mode, epics_helper::ClientMode::kConnection);
+  EXPECT_TRUE(epics_helper::ParseClientMode("get", mode));
+  EXPECT_EQ(mode, epics_helper::ClientMode::kGet);
+  EXPECT_FALSE(epics_helper::ParseClientMode("", mode));
+  EXPECT_FALSE(epics_helper::ParseClientMode("Connection", mode));
+  EXPECT_EQ(mode, epics_helper::ClientMode::kGet);
+}
+
+TEST_F(PvAccessClientVariableTest, ParseSeconds)
+{
+  sup::dto::uint64 duration_ns = 7;
+  EXPECT_TRUE(epics_helper::ParseSeconds("0", duration_ns));
+  EXPECT_EQ(duration_ns, 0u);
+  EXPECT_TRUE(epics_helper::ParseSeconds("1.5", duration_ns));
+  EXPECT_EQ(duration_ns, 1500000000u);
+  EXPECT_FALSE(epics_helper::ParseSeconds("", duration_ns));
+  EXPECT_FALSE(epics_helper::ParseSeconds("-0.5", duration_ns));
+  EXPECT_FALSE(epics_helper::ParseSeconds("1s", duration_ns));
+  EXPECT_FALSE(epics_helper::ParseSeconds("nan", duration_ns));
+  EXPECT_FALSE(epics_helper::ParseSeconds("1e30", duration_ns));
+  EXPECT_EQ(duration_ns, 1500000000u);
 }
 
 TEST_F(PvAccessClientVariableTest, NonExistingChannel)
@@ -156,6 +257,190 @@ TEST_F(PvAccessClientVariableTest, ServerClient)
   }));
 }
 
+//! Lazy variable only connects to the server when it is accessed.
+TEST_F(PvAccessClientVariableTest, LazyConnection)
+{
+  const std::string kDataType =
+      R"({"type":"testtype","attributes":[{"value":{"type":"float32"}}]})";
+  std::string channel = "PvAccessClientVariableTest:LazyFloatStruct";
+  sup::dto::JSONAnyTypeParser type_parser;
+  EXPECT_TRUE(type_parser.ParseString(kDataType));
+  sup::dto::AnyValue pv_val{type_parser.MoveAnyType()};
+  pv_val["value"] = 3.5f;
+
+  sup::epics::PvAccessServer server;
+  server.AddVariable(channel, pv_val);
+  server.Start();
+
+  Workspace ws;
+  auto variable = GlobalVariableRegistry().Create("PvAccessClient");
+  EXPECT_NO_THROW(variable->AddAttribute("channel", channel));
+  EXPECT_NO_THROW(variable->AddAttribute("type", kDataType));
+  EXPECT_NO_THROW(variable->AddAttribute("connect", "lazy"));
+  EXPECT_TRUE(ws.AddVariable("var", std::move(variable)));
+  EXPECT_NO_THROW(ws.Setup());
+
+  // First access creates the channel and waits for it to connect
+  sup::dto::AnyValue first_value;
+  ASSERT_TRUE(ws.GetValue("var", first_value));
+  EXPECT_EQ(first_value["value"], 3.5f);
+  EXPECT_TRUE(ws.SetValue("var.value", 4.5f));
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(2.0, [&server, channel]{
+    auto server_val = server.GetValue(channel);
+    return server_val.HasField("value") && server_val["value"] == 4.5f;
+  }));
+}
+
+//! Connection-only variable exposes the connection state as a read-only boolean.
+TEST_F(PvAccessClientVariableTest, ConnectionMode)
+{
+  const std::string kDataType =
+      R"({"type":"testtype","attributes":[{"value":{"type":"float32"}}]})";
+  std::string channel = "PvAccessClientVariableTest:ConnectionFloatStruct";
+  sup::dto::JSONAnyTypeParser type_parser;
+  EXPECT_TRUE(type_parser.ParseString(kDataType));
+  sup::dto::AnyValue pv_val{type_parser.MoveAnyType()};
+
+  Workspace ws;
+  auto variable = GlobalVariableRegistry().Create("PvAccessClient");
+  EXPECT_NO_THROW(variable->AddAttribute("channel", channel));
+  EXPECT_NO_THROW(variable->AddAttribute("mode", "connection"));
+  EXPECT_TRUE(ws.AddVariable("var", std::move(variable)));
+  EXPECT_NO_THROW(ws.Setup());
+
+  // Available before the channel connects
+  sup::dto::AnyValue connected;
+  EXPECT_TRUE(ws.GetValue("var", connected));
+  EXPECT_EQ(connected, false);
+
+  sup::epics::PvAccessServer server;
+  server.AddVariable(channel, pv_val);
+  server.Start();
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(5.0, [&ws]{
+    sup::dto::AnyValue tmp;
+    return ws.GetValue("var", tmp) && tmp == true;
+  }));
+  EXPECT_FALSE(ws.SetValue("var", false));
+}
+
+//! Get mode converts the value when it is read, unless the last value is recent enough.
+TEST_F(PvAccessClientVariableTest, GetMode)
+{
+  const std::string kDataType =
+      R"({"type":"testtype","attributes":[{"value":{"type":"float32"}}]})";
+  std::string channel = "PvAccessClientVariableTest:GetFloatStruct";
+  sup::dto::JSONAnyTypeParser type_parser;
+  EXPECT_TRUE(type_parser.ParseString(kDataType));
+  sup::dto::AnyValue pv_val{type_parser.MoveAnyType()};
+  pv_val["value"] = 1.5f;
+
+  sup::epics::PvAccessServer server;
+  server.AddVariable(channel, pv_val);
+  server.Start();
+
+  Workspace ws;
+  auto get_var = GlobalVariableRegistry().Create("PvAccessClient");
+  EXPECT_NO_THROW(get_var->AddAttribute("channel", channel));
+  EXPECT_NO_THROW(get_var->AddAttribute("type", kDataType));
+  EXPECT_NO_THROW(get_var->AddAttribute("mode", "get"));
+  EXPECT_NO_THROW(get_var->AddAttribute("timeout", "5.0"));
+  EXPECT_TRUE(ws.AddVariable("get", std::move(get_var)));
+  auto cached_var = GlobalVariableRegistry().Create("PvAccessClient");
+  EXPECT_NO_THROW(cached_var->AddAttribute("channel", channel));
+  EXPECT_NO_THROW(cached_var->AddAttribute("type", kDataType));
+  EXPECT_NO_THROW(cached_var->AddAttribute("mode", "get"));
+  EXPECT_NO_THROW(cached_var->AddAttribute("maxAge", "3600"));
+  EXPECT_NO_THROW(cached_var->AddAttribute("timeout", "5.0"));
+  EXPECT_TRUE(ws.AddVariable("cached", std::move(cached_var)));
+  EXPECT_NO_THROW(ws.Setup());
+
+  sup::dto::AnyValue value;
+  ASSERT_TRUE(ws.GetValue("get", value));
+  EXPECT_EQ(value["value"], 1.5f);
+  ASSERT_TRUE(ws.GetValue("cached", value));
+  EXPECT_EQ(value["value"], 1.5f);
+
+  // Only the variable without maxAge sees the new value
+  pv_val["value"] = 2.5f;
+  EXPECT_TRUE(server.SetValue(channel, pv_val));
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(5.0, [&ws]{
+    sup::dto::AnyValue tmp;
+    return ws.GetValue("get", tmp) && tmp["value"] == 2.5f;
+  }));
+  ASSERT_TRUE(ws.GetValue("cached", value));
+  EXPECT_EQ(value["value"], 1.5f);
+
+  // Read-only
+  EXPECT_FALSE(ws.SetValue("get.value", 3.5f));
+}
+
+TEST_F(PvAccessClientVariableTest, GetModeAvailability)
+{
+  const std::string kDataType =
+      R"({"type":"testtype","attributes":[{"value":{"type":"float32"}}]})";
+  std::string channel = "PvAccessClientVariableTest:GetAvailability";
+  sup::dto::JSONAnyTypeParser type_parser;
+  EXPECT_TRUE(type_parser.ParseString(kDataType));
+  sup::dto::AnyValue pv_val{type_parser.MoveAnyType()};
+  pv_val["value"] = 1.5f;
+
+  auto server = std::make_unique<sup::epics::PvAccessServer>();
+  server->AddVariable(channel, pv_val);
+  server->Start();
+
+  Workspace ws;
+  auto get_var = GlobalVariableRegistry().Create("PvAccessClient");
+  auto get_var_ptr = get_var.get();
+  EXPECT_NO_THROW(get_var->AddAttribute("channel", channel));
+  EXPECT_NO_THROW(get_var->AddAttribute("type", kDataType));
+  EXPECT_NO_THROW(get_var->AddAttribute("mode", "get"));
+  EXPECT_NO_THROW(get_var->AddAttribute("timeout", "5.0"));
+  EXPECT_TRUE(ws.AddVariable("get", std::move(get_var)));
+  auto missing_var = GlobalVariableRegistry().Create("PvAccessClient");
+  auto missing_var_ptr = missing_var.get();
+  EXPECT_NO_THROW(missing_var->AddAttribute("channel", "PvAccessClientVariableTest:Missing"));
+  EXPECT_NO_THROW(missing_var->AddAttribute("type", kDataType));
+  EXPECT_NO_THROW(missing_var->AddAttribute("mode", "get"));
+  EXPECT_NO_THROW(missing_var->AddAttribute("timeout", "0.1"));
+  EXPECT_TRUE(ws.AddVariable("missing", std::move(missing_var)));
+  EXPECT_NO_THROW(ws.Setup());
+
+  auto updates_received = [&channel]() {
+    for (const auto& statistics : epics_helper::GetVariableStatistics())
+    {
+      if (statistics->GetChannel() == channel)
+      {
+        return statistics->GetSnapshot().updates_received;
+      }
+    }
+    return sup::dto::uint64{0};
+  };
+
+  // Availability follows the connection and does not read the value
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(5.0, [get_var_ptr]{
+    return get_var_ptr->IsAvailable();
+  }));
+  EXPECT_EQ(updates_received(), 0);
+
+  // Reads use the same channel
+  sup::dto::AnyValue value;
+  ASSERT_TRUE(ws.GetValue("get", value));
+  EXPECT_EQ(updates_received(), 1);
+  ASSERT_TRUE(ws.GetValue("get", value));
+  EXPECT_EQ(updates_received(), 2);
+  EXPECT_TRUE(get_var_ptr->IsAvailable());
+
+  // Availability does not stay true after the channel is lost
+  server.reset();
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(5.0, [get_var_ptr]{
+    return !get_var_ptr->IsAvailable();
+  }));
+  EXPECT_FALSE(ws.GetValue("get", value));
+
+  EXPECT_FALSE(missing_var_ptr->IsAvailable());
+  EXPECT_FALSE(ws.GetValue("missing", value));
+}
+
 TEST_F(PvAccessClientVariableTest, ServerClientNoType)
 {
   const std::string kDataType =
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <oac-tree/pvxs/pv_access_diagnostics_variable.h>
+
+#include <sup/oac-tree/exceptions.h>
+#include <sup/oac-tree/variable_registry.h>
+#include <sup/oac-tree/workspace.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace sup::oac_tree;
+
+class PvAccessDiagnosticsVariableTest : public ::testing::Test
+{
+protected:
+  PvAccessDiagnosticsVariableTest();
+  ~PvAccessDiagnosticsVariableTest();
+};
+
+TEST_F(PvAccessDiagnosticsVariableTest, VariableRegistration)
+{
+  auto registry = GlobalVariableRegistry();
+  auto names = registry.RegisteredVariableNames();
+  ASSERT_TRUE(std::find(names.begin(), names.end(), PvAccessDiagnosticsVariable::Type)
+              != names.end());
+  EXPECT_TRUE(dynamic_cast<PvAccessDiagnosticsVariable*>(
+    registry.Create(PvAccessDiagnosticsVariable::Type).get()));
+}
+
+TEST_F(PvAccessDiagnosticsVariableTest, Setup)
+{
+  Workspace ws;
+  // channel attribute is mandatory
+  {
+    PvAccessDiagnosticsVariable variable;
+    EXPECT_THROW(variable.Setup(ws), VariableSetupException);
+    EXPECT_TRUE(variable.AddAttribute("channel", "pvaccess-diagnostics-var-test::setup"));
+    EXPECT_NO_THROW(variable.Setup(ws));
+    EXPECT_NO_THROW(variable.Teardown());
+  }
+  // period attribute must be a positive number
+  {
+    PvAccessDiagnosticsVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "pvaccess-diagnostics-var-test::setup"));
+    EXPECT_TRUE(variable.AddAttribute("period", "cannot_be_parsed"));
+    EXPECT_THROW(variable.Setup(ws), VariableSetupException);
+  }
+  {
+    PvAccessDiagnosticsVariable variable;
+    EXPECT_TRUE(variable.AddAttribute("channel", "pvaccess-diagnostics-var-test::setup"));
+    EXPECT_TRUE(variable.AddAttribute("period", "0"));
+    EXPECT_THROW(variable.Setup(ws), VariableSetupException);
+  }
+}
+
+TEST_F(PvAccessDiagnosticsVariableTest, PeriodicUpdates)
+{
+  Workspace ws;
+  auto variable = GlobalVariableRegistry().Create(PvAccessDiagnosticsVariable::Type);
+  EXPECT_NO_THROW(variable->AddAttribute("channel", "pvaccess-diagnostics-var-test::periodic"));
+  EXPECT_NO_THROW(variable->AddAttribute("period", "0.05"));
+  EXPECT_TRUE(ws.AddVariable("diagnostics", std::move(variable)));
+  EXPECT_NO_THROW(ws.Setup());
+
+  // Diagnostics are available right after setup
+  sup::dto::AnyValue first_value;
+  EXPECT_TRUE(ws.GetValue("diagnostics", first_value));
+  EXPECT_EQ(first_value.GetType(), PluginDiagnosticsType());
+  EXPECT_TRUE(first_value.HasField("outstanding_rpcs"));
+  EXPECT_TRUE(first_value.HasField("time_to_all_connected"));
+  EXPECT_TRUE(first_value.HasField("pending_since"));
+  EXPECT_TRUE(first_value.HasField("skipped_writes"));
+  EXPECT_TRUE(first_value.HasField("prefetched_channels"));
+
+  // Diagnostics are read-only
+  EXPECT_FALSE(ws.SetValue("diagnostics", first_value));
+
+  // Timestamp is refreshed periodically
+  auto first_timestamp = first_value["timestamp"].As<sup::dto::uint64>();
+  bool updated = false;
+  for (int i = 0; i < 50 && !updated; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    sup::dto::AnyValue value;
+    EXPECT_TRUE(ws.GetValue("diagnostics", value));
+    updated = value["timestamp"].As<sup::dto::uint64>() > first_timestamp;
+  }
+  EXPECT_TRUE(updated);
+  EXPECT_NO_THROW(ws.Teardown());
+}
+
+PvAccessDiagnosticsVariableTest::PvAccessDiagnosticsVariableTest() = default;
+PvAccessDiagnosticsVariableTest::~PvAccessDiagnosticsVariableTest() = default;
@@ -22,6 +22,8 @@
 
 #include <oac-tree/pvxs/pv_access_helper.h>
 
+#include <sup/dto/anyvalue_helper.h>
+
 #include <gtest/gtest.h>
 
 using namespace sup::oac_tree;
@@ -224,5 +226,207 @@ TEST_F(PvAccessHelperTest, ConvertToArrayTargetType)
   }
 }
 
+TEST_F(PvAccessHelperTest, ConvertNumericArrays)
+{
+  {
+    // Unsigned integer array converts losslessly to floating point array
+    sup::dto::AnyType anytype{4, sup::dto::Float64Type};
+    sup::dto::AnyValue value =
+      sup::dto::ArrayValue({ {sup::dto::UnsignedInteger32Type, 0U }, 1U, 4000000000U, 7U});
+    sup::dto::AnyValue expected =
+      sup::dto::ArrayValue({ {sup::dto::Float64Type, 0.0 }, 1.0, 4000000000.0, 7.0});
+    auto result = pv_access_helper::ConvertToTypedAnyValue(value, anytype);
+    EXPECT_EQ(result, expected);
+  }
+  {
+    // Array members of a structure are converted, other members as before
+    sup::dto::AnyType anytype = {{
+      { "mode", sup::dto::UnsignedInteger16Type },
+      { "samples", sup::dto::AnyType{3, sup::dto::Float32Type} }
+    }};
+    sup::dto::AnyValue value = {{
+      { "mode", {sup::dto::UnsignedInteger8Type, 3U }},
+      { "samples", sup::dto::ArrayValue({ {sup::dto::SignedInteger16Type, -32768 }, 0, 32767}) },
+      { "extra", {sup::dto::Float64Type, 3.14 }}
+    }};
+    sup::dto::AnyValue expected = {{
+      { "mode", {sup::dto::UnsignedInteger16Type, 3U }},
+      { "samples", sup::dto::ArrayValue({ {sup::dto::Float32Type, -32768.0f }, 0.0f, 32767.0f}) }
+    }};
+    auto result = pv_access_helper::ConvertToTypedAnyValue(value, anytype);
+    EXPECT_EQ(result, expected);
+  }
+  {
+    // Structure with missing member will not convert
+    sup::dto::AnyType anytype = {{
+      { "mode", sup::dto::UnsignedInteger16Type },
+      { "samples", sup::dto::AnyType{3, sup::dto::Float32Type} }
+    }};
+    sup::dto::AnyValue value = {{
+      { "samples", sup::dto::ArrayValue({ {sup::dto::SignedInteger16Type, -1 }, 0, 1}) }
+    }};
+    sup::dto::AnyValue expected{};
+    auto result = pv_access_helper::ConvertToTypedAnyValue(value, anytype);
+    EXPECT_EQ(result, expected);
+  }
+  {
+    // Lossy conversions still use the range checked conversion
+    sup::dto::AnyType anytype{2, sup::dto::UnsignedInteger8Type};
+    sup::dto::AnyValue value = sup::dto::ArrayValue({ {sup::dto::Float64Type, 1.0 }, 256.0});
+    sup::dto::AnyValue expected{};
+    auto result = pv_access_helper::ConvertToTypedAnyValue(value, anytype);
+    EXPECT_EQ(result, expected);
+  }
+}
+
+TEST_F(PvAccessHelperTest, ConvertWithScalarConversion)
+{
+  sup::dto::AnyType anytype{sup::dto::Float64Type};
+  epics_helper::ScalarConversion conversion{anytype};
+  {
+    // Lossless conversion uses the specialized converter
+    sup::dto::AnyValue value = {{
+      { pv_access_helper::VALUE_FIELD_NAME, {sup::dto::SignedInteger32Type, -3 }}
+    }};
+    auto result = pv_access_helper::ConvertToTypedAnyValue(value, anytype, conversion);
+    EXPECT_EQ(result, sup::dto::AnyValue(sup::dto::Float64Type, -3.0));
+  }
+  {
+    // Other conversions fall back to the generic conversion
+    sup::dto::AnyValue value = {{
+      { pv_access_helper::VALUE_FIELD_NAME, {sup::dto::StringType, "2.5" }}
+    }};
+    auto result = pv_access_helper::ConvertToTypedAnyValue(value, anytype, conversion);
+    EXPECT_EQ(result, pv_access_helper::ConvertToTypedAnyValue(value, anytype));
+  }
+  {
+    // Structure without value field
+    sup::dto::AnyValue value = {{
+      { "setpoint", {sup::dto::Float64Type, 2.5 }}
+    }};
+    auto result = pv_access_helper::ConvertToTypedAnyValue(value, anytype, conversion);
+    EXPECT_TRUE(sup::dto::IsEmptyValue(result));
+  }
+}
+
+TEST_F(PvAccessHelperTest, WireValue)
+{
+  {
+    // Scalars are wrapped in a structure that is updated in place
+    sup::dto::AnyType anytype{sup::dto::Float64Type};
+    auto wire_value = pv_access_helper::CreateWireValue(anytype);
+    ASSERT_TRUE(wire_value.HasField(pv_access_helper::VALUE_FIELD_NAME));
+    EXPECT_TRUE(pv_access_helper::ConvertIntoWireValue(
+      wire_value, anytype, sup::dto::AnyValue{sup::dto::SignedInteger32Type, 42}));
+    sup::dto::AnyValue expected = {{
+      { pv_access_helper::VALUE_FIELD_NAME, {sup::dto::Float64Type, 42.0 }}
+    }};
+    EXPECT_EQ(wire_value, expected);
+    EXPECT_TRUE(pv_access_helper::ConvertIntoWireValue(
+      wire_value, anytype, sup::dto::AnyValue{sup::dto::Float64Type, 3.5}));
+    EXPECT_EQ(wire_value[pv_access_helper::VALUE_FIELD_NAME].As<sup::dto::float64>(), 3.5);
+    EXPECT_FALSE(pv_access_helper::ConvertIntoWireValue(
+      wire_value, anytype, sup::dto::AnyValue{sup::dto::StringType, "not a number"}));
+  }
+  {
+    // Structures are not wrapped
+    sup::dto::AnyType anytype = {{
+      { "mode", sup::dto::UnsignedInteger16Type },
+      { "setpoint", sup::dto::Float64Type }
+    }};
+    auto wire_value = pv_access_helper::CreateWireValue(anytype);
+    EXPECT_EQ(wire_value.GetType(), anytype);
+    sup::dto::AnyValue value = {{
+      { "mode", {sup::dto::UnsignedInteger8Type, 3U }},
+      { "setpoint", {sup::dto::Float64Type, 3.14 }}
+    }};
+    EXPECT_TRUE(pv_access_helper::ConvertIntoWireValue(wire_value, anytype, value));
+    EXPECT_EQ(wire_value["mode"].As<sup::dto::uint16>(), 3U);
+    EXPECT_EQ(wire_value["setpoint"].As<sup::dto::float64>(), 3.14);
+  }
+  {
+    // Numeric arrays
+    sup::dto::AnyType anytype{3, sup::dto::Float64Type};
+    auto wire_value = pv_access_helper::CreateWireValue(anytype);
+    sup::dto::AnyValue value =
+      sup::dto::ArrayValue({ {sup::dto::UnsignedInteger32Type, 1U }, 2U, 3U});
+    sup::dto::AnyValue expected =
+      sup::dto::ArrayValue({ {sup::dto::Float64Type, 1.0 }, 2.0, 3.0});
+    EXPECT_TRUE(pv_access_helper::ConvertIntoWireValue(wire_value, anytype, value));
+    EXPECT_EQ(wire_value, expected);
+  }
+}
+
+TEST_F(PvAccessHelperTest, GetTimestamp)
+{
+  {
+    // Normative type timestamp
+    sup::dto::AnyValue value = {{
+      { pv_access_helper::VALUE_FIELD_NAME, {sup::dto::Float64Type, 1.5 }},
+      { pv_access_helper::TIMESTAMP_FIELD_NAME, {
+        { pv_access_helper::SECONDS_FIELD_NAME, {sup::dto::SignedInteger64Type, 1700000000 }},
+        { pv_access_helper::NANOSECONDS_FIELD_NAME, {sup::dto::SignedInteger32Type, 250 }},
+        { "userTag", {sup::dto::SignedInteger32Type, 0 }}
+      }}
+    }};
+    EXPECT_EQ(pv_access_helper::GetTimestamp(value), 1700000000000000250ULL);
+  }
+  {
+    // No or malformed timestamp
+    EXPECT_EQ(pv_access_helper::GetTimestamp(sup::dto::AnyValue{}), 0);
+    EXPECT_EQ(pv_access_helper::GetTimestamp(sup::dto::AnyValue{sup::dto::UnsignedInteger64Type,
+                                                                 42U}), 0);
+    sup::dto::AnyValue value = {{
+      { pv_access_helper::TIMESTAMP_FIELD_NAME, {sup::dto::UnsignedInteger64Type, 42U }}
+    }};
+    EXPECT_EQ(pv_access_helper::GetTimestamp(value), 0);
+    sup::dto::AnyValue negative = {{
+      { pv_access_helper::TIMESTAMP_FIELD_NAME, {
+        { pv_access_helper::SECONDS_FIELD_NAME, {sup::dto::SignedInteger64Type, -1 }},
+        { pv_access_helper::NANOSECONDS_FIELD_NAME, {sup::dto::SignedInteger32Type, 0 }}
+      }}
+    }};
+    EXPECT_EQ(pv_access_helper::GetTimestamp(negative), 0);
+  }
+}
+
+TEST_F(PvAccessHelperTest, HoldsValue)
+{
+  sup::dto::AnyValue remote = {{
+    { pv_access_helper::VALUE_FIELD_NAME, {sup::dto::Float64Type, 1.5 }},
+    { "alarm", {
+      { "severity", {sup::dto::SignedInteger32Type, 0 }},
+      { "message", {sup::dto::StringType, "" }}
+    }}
+  }};
+  {
+    // Identical values and packed scalars matching the remote fields
+    EXPECT_TRUE(pv_access_helper::HoldsValue(remote, remote));
+    auto value = pv_access_helper::PackIntoStructIfScalar(
+      sup::dto::AnyValue{sup::dto::Float64Type, 1.5});
+    EXPECT_TRUE(pv_access_helper::HoldsValue(remote, value));
+    sup::dto::AnyValue nested = {{
+      { "alarm", {
+        { "severity", {sup::dto::SignedInteger32Type, 0 }}
+      }}
+    }};
+    EXPECT_TRUE(pv_access_helper::HoldsValue(remote, nested));
+  }
+  {
+    // Different field values, types or missing fields
+    auto value = pv_access_helper::PackIntoStructIfScalar(
+      sup::dto::AnyValue{sup::dto::Float64Type, 2.5});
+    EXPECT_FALSE(pv_access_helper::HoldsValue(remote, value));
+    value = pv_access_helper::PackIntoStructIfScalar(
+      sup::dto::AnyValue{sup::dto::StringType, "1.5"});
+    EXPECT_FALSE(pv_access_helper::HoldsValue(remote, value));
+    sup::dto::AnyValue other = {{
+      { "setpoint", {sup::dto::Float64Type, 1.5 }}
+    }};
+    EXPECT_FALSE(pv_access_helper::HoldsValue(remote, other));
+    EXPECT_FALSE(pv_access_helper::HoldsValue(sup::dto::AnyValue{}, other));
+  }
+}
+
 PvAccessHelperTest::PvAccessHelperTest() = default;
 PvAccessHelperTest::~PvAccessHelperTest() = default;
@@ -23,6 +23,7 @@
 #include "test_user_interface.h"
 #include "unit_test_helper.h"
 
+#include <oac-tree/common/plugin_diagnostics.h>
 #include <oac-tree/pvxs/pv_access_read_instruction.h>
 
 #include <sup/epics/pv_access_server.h>
@@ -234,6 +235,69 @@ R"RAW(
   EXPECT_TRUE(unit_test_helper::TryAndExecute(proc, ui));
 }
 
+TEST_F(PvAccessReadInstructionTest, RepeatedReadLiteralChannel)
+{
+  // Channel is created during setup and used by the first iteration: Repeat resets its child,
+  // which releases the channel
+  DefaultUserInterface ui;
+  const std::string procedure_body{
+R"RAW(
+  <RegisterType jsontype='{"type":"seq::pva_read_test::Type/v1.0","attributes":[{"value":{"type":"float32"}}]}'/>
+  <Repeat maxCount="3">
+    <Sequence>
+      <PvAccessRead channel="pva-read-instr-test::variable4" outputVar="pvxs-value" timeout="2.0"/>
+      <Equals leftVar="pvxs-variable" rightVar="pvxs-value"/>
+    </Sequence>
+  </Repeat>
+  <Workspace>
+    <PvAccessServer name="pvxs-variable"
+                    channel="pva-read-instr-test::variable4"
+                    type='{"type":"seq::pva_read_test::Type/v1.0"}'
+                    value='{"value":1.0}'/>
+    <Local name="pvxs-value"
+           type='{"type":"seq::pva_read_test::Type/v1.0"}'
+           value='{"value":0.0}'/>
+  </Workspace>
+)RAW"};
+
+  const auto procedure_string = unit_test_helper::CreateProcedureString(procedure_body);
+  auto proc = ParseProcedureString(procedure_string);
+  auto prefetched_before = epics_helper::CollectPluginDiagnostics().prefetched_channels;
+  EXPECT_TRUE(unit_test_helper::TryAndExecute(proc, ui));
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().prefetched_channels, prefetched_before + 1);
+}
+
+TEST_F(PvAccessReadInstructionTest, ReadFromMonitor)
+{
+  // Value is taken from the client variable that monitors the same channel
+  DefaultUserInterface ui;
+  const std::string procedure_body{
+R"RAW(
+  <RegisterType jsontype='{"type":"seq::pva_read_test::Type/v1.0","attributes":[{"value":{"type":"float32"}}]}'/>
+  <Sequence>
+    <WaitForVariable varName="pvxs-monitor" timeout="5.0"/>
+    <PvAccessRead channel="pva-read-instr-test::variable7" outputVar="pvxs-value" maxAge="3600.0"/>
+    <Equals leftVar="pvxs-variable" rightVar="pvxs-value"/>
+  </Sequence>
+  <Workspace>
+    <PvAccessServer name="pvxs-variable"
+                    channel="pva-read-instr-test::variable7"
+                    type='{"type":"seq::pva_read_test::Type/v1.0"}'
+                    value='{"value":3.0}'/>
+    <PvAccessClient name="pvxs-monitor"
+                    channel="pva-read-instr-test::variable7"
+                    type='{"type":"seq::pva_read_test::Type/v1.0"}'/>
+    <Local name="pvxs-value"
+           type='{"type":"seq::pva_read_test::Type/v1.0"}'
+           value='{"value":0.0}'/>
+  </Workspace>
+)RAW"};
+
+  const auto procedure_string = unit_test_helper::CreateProcedureString(procedure_body);
+  auto proc = ParseProcedureString(procedure_string);
+  EXPECT_TRUE(unit_test_helper::TryAndExecute(proc, ui));
+}
+
 TEST_F(PvAccessReadInstructionTest, VariableAttributesWrongType)
 {
   DefaultUserInterface ui;
@@ -20,6 +20,7 @@
  * of the distribution package.
  ******************************************************************************/
 
+#include <oac-tree/common/variable_statistics.h>
 #include <oac-tree/pvxs/pv_access_server_variable.h>
 
 #include <sup/oac-tree/exceptions.h>
@@ -209,6 +210,23 @@ TEST_F(PvAccessServerVariableTest, ServerClientTest)
            server_val.HasField("value") &&
            server_val["value"] == new_value;
   }));
+
+  // Both variables recorded the updates they received
+  std::size_t n_statistics = 0;
+  for (const auto& statistics : epics_helper::GetVariableStatistics())
+  {
+    if (statistics->GetChannel() != channel)
+    {
+      continue;
+    }
+    ++n_statistics;
+    auto snapshot = statistics->GetSnapshot();
+    EXPECT_GE(snapshot.updates_received, 1) << statistics->GetVariableType();
+    EXPECT_EQ(snapshot.conversion_failures, 0) << statistics->GetVariableType();
+    EXPECT_GE(snapshot.notify_count, snapshot.updates_received) << statistics->GetVariableType();
+    EXPECT_GE(snapshot.last_update_age, 0.0) << statistics->GetVariableType();
+  }
+  EXPECT_EQ(n_statistics, 2);
 }
 
 PvAccessServerVariableTest::PvAccessServerVariableTest() = default;
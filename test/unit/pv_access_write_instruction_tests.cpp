@@ -23,6 +23,7 @@
 #include "test_user_interface.h"
 #include "unit_test_helper.h"
 
+#include <oac-tree/common/plugin_diagnostics.h>
 #include <oac-tree/pvxs/pv_access_write_instruction.h>
 
 #include <sup/oac-tree/exceptions.h>
@@ -320,6 +321,63 @@ TEST_F(PvAccessWriteInstructionTest, Success)
   }));
 }
 
+TEST_F(PvAccessWriteInstructionTest, OnlyIfChanged)
+{
+  Procedure proc;
+  Workspace ws;
+  auto server_var = GlobalVariableRegistry().Create("PvAccessServer");
+  ASSERT_TRUE(static_cast<bool>(server_var));
+  EXPECT_NO_THROW(server_var->AddAttribute("channel", "seq::write-test::var_6"));
+  EXPECT_NO_THROW(server_var->AddAttribute("type", UINT16_STRUCT_TYPE));
+  EXPECT_TRUE(ws.AddVariable("server", std::move(server_var)));
+  auto client_var = GlobalVariableRegistry().Create("PvAccessClient");
+  ASSERT_TRUE(static_cast<bool>(client_var));
+  EXPECT_NO_THROW(client_var->AddAttribute("channel", "seq::write-test::var_6"));
+  EXPECT_TRUE(ws.AddVariable("client", std::move(client_var)));
+  EXPECT_NO_THROW(ws.Setup());
+  EXPECT_TRUE(ws.WaitForVariable("client", 5.0));
+
+  // Scalar value to write is packed into the 'value' field and compared with that field only
+  auto instruction = GlobalInstructionRegistry().Create("PvAccessWrite");
+  ASSERT_TRUE(static_cast<bool>(instruction));
+  EXPECT_TRUE(instruction->AddAttribute("channel", "seq::write-test::var_6"));
+  EXPECT_TRUE(instruction->AddAttribute("type", R"RAW({"type":"uint16"})RAW"));
+  EXPECT_TRUE(instruction->AddAttribute("value", "42"));
+  EXPECT_TRUE(instruction->AddAttribute("timeout", "5.0"));
+  EXPECT_TRUE(instruction->AddAttribute("onlyIfChanged", "true"));
+  auto execute = [&]() {
+    EXPECT_NO_THROW(instruction->Setup(proc));
+    while (!IsFinishedStatus(instruction->GetStatus()))
+    {
+      EXPECT_NO_THROW(instruction->ExecuteSingle(ui, ws));
+    }
+    EXPECT_EQ(instruction->GetStatus(), ExecutionStatus::SUCCESS);
+    EXPECT_NO_THROW(instruction->Reset(ui));
+  };
+  auto skipped_before = epics_helper::CollectPluginDiagnostics().skipped_writes;
+  execute();
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().skipped_writes, skipped_before);
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(2.0, [&ws]{
+    sup::dto::AnyValue client_val;
+    return ws.GetValue("client", client_val) && client_val.HasField("value") &&
+           client_val["value"].As<sup::dto::uint16>() == 42;
+  }));
+
+  // Writing the same value again is skipped
+  execute();
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().skipped_writes, skipped_before + 1);
+
+  // A different value is written
+  EXPECT_TRUE(instruction->SetAttribute("value", "7"));
+  execute();
+  EXPECT_EQ(epics_helper::CollectPluginDiagnostics().skipped_writes, skipped_before + 1);
+  EXPECT_TRUE(sup::epics::test::BusyWaitFor(2.0, [&ws]{
+    sup::dto::AnyValue client_val;
+    return ws.GetValue("client", client_val) && client_val.HasField("value") &&
+           client_val["value"].As<sup::dto::uint16>() == 7;
+  }));
+}
+
 TEST_F(PvAccessWriteInstructionTest, VariableAttributes)
 {
   DefaultUserInterface ui;
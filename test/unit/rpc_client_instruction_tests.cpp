@@ -39,7 +39,9 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <memory>
+#include <thread>
 
 static const std::string REQUEST_TYPE =
   R"RAW({"type":"sup::RPCRequest/v1.0","attributes":[{"timestamp":{"type":"uint64"}},{"query":{"type":"uint16"}}]})RAW";
@@ -289,6 +291,33 @@ TEST_F(RPCClientInstructionTest, ServiceTimeout)
   EXPECT_EQ(instruction.GetStatus(), ExecutionStatus::FAILURE);
 }
 
+TEST_F(RPCClientInstructionTest, HaltDuringRequest)
+{
+  Procedure proc;
+  Workspace ws;
+
+  RPCClientInstruction instruction{};
+  EXPECT_TRUE(instruction.AddAttribute("service", "Does_Not_Exist"));
+  EXPECT_TRUE(instruction.AddAttribute("type", REQUEST_TYPE));
+  EXPECT_TRUE(instruction.AddAttribute("value", REQUEST_VALUE));
+  EXPECT_TRUE(instruction.AddAttribute("timeout", "10.0"));
+  EXPECT_NO_THROW(instruction.Setup(proc));
+
+  // Halting wakes up the instruction long before the timeout expires
+  auto start = std::chrono::steady_clock::now();
+  std::thread halt_thread{[this, &instruction]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    instruction.Halt(ui);
+  }};
+  while (!IsFinishedStatus(instruction.GetStatus()))
+  {
+    EXPECT_NO_THROW(instruction.ExecuteSingle(ui, ws));
+  }
+  halt_thread.join();
+  EXPECT_EQ(instruction.GetStatus(), ExecutionStatus::FAILURE);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
 TEST_F(RPCClientInstructionTest, MissingOutput)
 {
   Procedure proc;
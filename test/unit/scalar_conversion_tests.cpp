@@ -0,0 +1,83 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <oac-tree/common/scalar_conversion.h>
+
+#include <sup/dto/anyvalue_helper.h>
+
+#include <gtest/gtest.h>
+
+using namespace sup::oac_tree;
+
+class ScalarConversionTest : public ::testing::Test
+{
+protected:
+  ScalarConversionTest();
+  ~ScalarConversionTest();
+};
+
+TEST_F(ScalarConversionTest, SelectScalarConverter)
+{
+  using sup::dto::TypeCode;
+  using epics_helper::SelectScalarConverter;
+  EXPECT_NE(SelectScalarConverter(TypeCode::Float64, TypeCode::Float64), nullptr);
+  EXPECT_NE(SelectScalarConverter(TypeCode::Int32, TypeCode::Int32), nullptr);
+  EXPECT_NE(SelectScalarConverter(TypeCode::Bool, TypeCode::Bool), nullptr);
+  EXPECT_NE(SelectScalarConverter(TypeCode::Int32, TypeCode::Float64), nullptr);
+  EXPECT_NE(SelectScalarConverter(TypeCode::UInt8, TypeCode::Int16), nullptr);
+
+  // Conversions that need range checks or parsing use the generic conversion
+  EXPECT_EQ(SelectScalarConverter(TypeCode::Float64, TypeCode::Int32), nullptr);
+  EXPECT_EQ(SelectScalarConverter(TypeCode::Int32, TypeCode::UInt32), nullptr);
+  EXPECT_EQ(SelectScalarConverter(TypeCode::Bool, TypeCode::Int32), nullptr);
+  EXPECT_EQ(SelectScalarConverter(TypeCode::String, TypeCode::String), nullptr);
+
+  // Converter refuses sources of another type
+  auto converter = SelectScalarConverter(TypeCode::Int32, TypeCode::Float64);
+  ASSERT_NE(converter, nullptr);
+  EXPECT_EQ(converter(sup::dto::AnyValue{sup::dto::SignedInteger32Type, -7}),
+            sup::dto::AnyValue(sup::dto::Float64Type, -7.0));
+  EXPECT_TRUE(sup::dto::IsEmptyValue(converter(sup::dto::AnyValue{sup::dto::Float32Type, 1.0})));
+}
+
+TEST_F(ScalarConversionTest, Convert)
+{
+  epics_helper::ScalarConversion conversion{sup::dto::Float64Type};
+  EXPECT_EQ(conversion.Convert(sup::dto::AnyValue{sup::dto::Float64Type, 2.5}),
+            sup::dto::AnyValue(sup::dto::Float64Type, 2.5));
+
+  // Source type changes select another converter
+  EXPECT_EQ(conversion.Convert(sup::dto::AnyValue{sup::dto::UnsignedInteger16Type, 42U}),
+            sup::dto::AnyValue(sup::dto::Float64Type, 42.0));
+  EXPECT_TRUE(sup::dto::IsEmptyValue(
+    conversion.Convert(sup::dto::AnyValue{sup::dto::SignedInteger64Type, 42})));
+  EXPECT_EQ(conversion.Convert(sup::dto::AnyValue{sup::dto::Float32Type, 0.5}),
+            sup::dto::AnyValue(sup::dto::Float64Type, 0.5));
+
+  // Default constructed conversion never applies
+  epics_helper::ScalarConversion empty_conversion{};
+  EXPECT_TRUE(sup::dto::IsEmptyValue(
+    empty_conversion.Convert(sup::dto::AnyValue{sup::dto::Float64Type, 2.5})));
+}
+
+ScalarConversionTest::ScalarConversionTest() = default;
+ScalarConversionTest::~ScalarConversionTest() = default;
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+#include <oac-tree/common/trace.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace sup::oac_tree;
+
+class TraceTest : public ::testing::Test
+{
+protected:
+  TraceTest();
+  ~TraceTest();
+
+  static std::string ReadFile(const std::string& filename);
+  static std::size_t CountOccurrences(const std::string& text, const std::string& pattern);
+
+  std::string m_filename;
+};
+
+TEST_F(TraceTest, DisabledTracing)
+{
+  epics_helper::DisableTracing();
+  EXPECT_FALSE(epics_helper::IsTracingEnabled());
+  {
+    epics_helper::TraceSpan span{"TraceTest.disabled"};
+  }
+  epics_helper::TraceInstant("TraceTest.disabled");
+  EXPECT_NO_THROW(epics_helper::FlushTrace());
+}
+
+TEST_F(TraceTest, ChromeTraceFile)
+{
+  const std::size_t n_threads = 4;
+  const std::size_t n_spans = 100;
+  epics_helper::EnableTracing(m_filename);
+  EXPECT_TRUE(epics_helper::IsTracingEnabled());
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < n_threads; ++i)
+  {
+    threads.emplace_back([n_spans]() {
+      for (std::size_t j = 0; j < n_spans; ++j)
+      {
+        epics_helper::TraceSpan span{"TraceTest.span"};
+      }
+      epics_helper::TraceInstant("TraceTest.instant");
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  // Events of threads that exited are kept until flushed
+  epics_helper::FlushTrace();
+  {
+    epics_helper::TraceSpan span{"TraceTest.main"};
+  }
+  epics_helper::DisableTracing();
+  EXPECT_FALSE(epics_helper::IsTracingEnabled());
+
+  auto content = ReadFile(m_filename);
+  ASSERT_FALSE(content.empty());
+  EXPECT_EQ(content.front(), '[');
+  EXPECT_EQ(content.find_last_not_of("\n"), content.rfind(']'));
+  EXPECT_EQ(CountOccurrences(content, R"("name":"TraceTest.span")"), n_threads * n_spans);
+  EXPECT_EQ(CountOccurrences(content, R"("name":"TraceTest.instant")"), n_threads);
+  EXPECT_EQ(CountOccurrences(content, R"("name":"TraceTest.main")"), 1);
+  EXPECT_EQ(CountOccurrences(content, R"("ph":"X")"), n_threads * n_spans + 1);
+  EXPECT_EQ(epics_helper::DroppedTraceEvents(), 0);
+}
+
+TEST_F(TraceTest, FullBufferDropsEvents)
+{
+  // Larger than the buffer of a thread
+  const std::size_t n_spans = 10000;
+  epics_helper::EnableTracing(m_filename);
+  auto dropped_before = epics_helper::DroppedTraceEvents();
+  std::thread thread([n_spans]() {
+    for (std::size_t j = 0; j < n_spans; ++j)
+    {
+      epics_helper::TraceSpan span{"TraceTest.span"};
+    }
+  });
+  thread.join();
+  epics_helper::DisableTracing();
+  auto dropped = epics_helper::DroppedTraceEvents() - dropped_before;
+  EXPECT_GT(dropped, 0);
+  auto content = ReadFile(m_filename);
+  EXPECT_EQ(CountOccurrences(content, R"("name":"TraceTest.span")") + dropped, n_spans);
+}
+
+TraceTest::TraceTest()
+  : m_filename{"trace_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed())
+               + ".json"}
+{}
+
+TraceTest::~TraceTest()
+{
+  epics_helper::DisableTracing();
+  (void)std::remove(m_filename.c_str());
+}
+
+std::string TraceTest::ReadFile(const std::string& filename)
+{
+  std::ifstream file{filename};
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+std::size_t TraceTest::CountOccurrences(const std::string& text, const std::string& pattern)
+{
+  std::size_t result = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + pattern.size()))
+  {
+    ++result;
+  }
+  return result;
+}
@@ -0,0 +1,202 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <oac-tree/common/variable_statistics.h>
+
+#include <sup/dto/anytype.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace sup::oac_tree;
+
+using StatisticsPtr = std::shared_ptr<const epics_helper::VariableStatistics>;
+
+class VariableStatisticsTest : public ::testing::Test
+{
+protected:
+  VariableStatisticsTest();
+  ~VariableStatisticsTest();
+
+  static bool IsRegistered(const epics_helper::VariableStatistics* statistics);
+};
+
+TEST_F(VariableStatisticsTest, Counters)
+{
+  epics_helper::VariableStatistics statistics{"TestVariable", "test::channel"};
+  EXPECT_EQ(statistics.GetVariableType(), "TestVariable");
+  EXPECT_EQ(statistics.GetChannel(), "test::channel");
+  auto snapshot = statistics.GetSnapshot();
+  EXPECT_EQ(snapshot.updates_received, 0);
+  EXPECT_EQ(snapshot.conversion_failures, 0);
+  EXPECT_EQ(snapshot.notify_count, 0);
+  EXPECT_EQ(snapshot.bytes_received, 0);
+  EXPECT_LT(snapshot.last_update_age, 0.0);
+  EXPECT_EQ(snapshot.jitter, 0.0);
+
+  statistics.RecordUpdate(8);
+  statistics.RecordNotify();
+  statistics.RecordUpdate(8);
+  statistics.RecordConversionFailure();
+  statistics.RecordNotify();
+  snapshot = statistics.GetSnapshot();
+  EXPECT_EQ(snapshot.updates_received, 2);
+  EXPECT_EQ(snapshot.conversion_failures, 1);
+  EXPECT_EQ(snapshot.notify_count, 2);
+  EXPECT_EQ(snapshot.bytes_received, 16);
+  EXPECT_GE(snapshot.last_update_age, 0.0);
+  EXPECT_LT(snapshot.last_update_age, 10.0);
+
+  // Counters of different variables never share a cache line
+  EXPECT_EQ(alignof(epics_helper::VariableStatistics), epics_helper::CACHE_LINE_SIZE);
+}
+
+TEST_F(VariableStatisticsTest, Jitter)
+{
+  epics_helper::VariableStatistics statistics{"TestVariable", "test::channel"};
+  // Jitter requires at least two inter-arrival times
+  statistics.RecordUpdate(0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  statistics.RecordUpdate(0);
+  EXPECT_EQ(statistics.GetSnapshot().jitter, 0.0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  statistics.RecordUpdate(0);
+  auto jitter = statistics.GetSnapshot().jitter;
+  EXPECT_GT(jitter, 0.0);
+  EXPECT_LT(jitter, 1.0);
+}
+
+TEST_F(VariableStatisticsTest, ConcurrentWriters)
+{
+  epics_helper::VariableStatistics statistics{"TestVariable", "test::channel"};
+  const int n_threads = 4;
+  const int n_updates = 1000;
+  std::vector<std::thread> writers;
+  for (int i = 0; i < n_threads; ++i)
+  {
+    writers.emplace_back([&statistics]() {
+      for (int j = 0; j < n_updates; ++j)
+      {
+        statistics.RecordUpdate(2);
+        statistics.RecordNotify();
+      }
+    });
+  }
+  for (auto& writer : writers)
+  {
+    writer.join();
+  }
+  auto snapshot = statistics.GetSnapshot();
+  EXPECT_EQ(snapshot.updates_received, n_threads * n_updates);
+  EXPECT_EQ(snapshot.notify_count, n_threads * n_updates);
+  EXPECT_EQ(snapshot.bytes_received, 2 * n_threads * n_updates);
+  EXPECT_GE(snapshot.last_update_age, 0.0);
+  EXPECT_GE(snapshot.jitter, 0.0);
+}
+
+TEST_F(VariableStatisticsTest, Disabled)
+{
+  EXPECT_TRUE(epics_helper::VariableStatisticsEnabled());
+  epics_helper::SetVariableStatisticsEnabled(false);
+  auto statistics = epics_helper::CreateVariableStatistics("TestVariable", "test::disabled");
+  epics_helper::SetVariableStatisticsEnabled(true);
+  statistics->RecordUpdate(8);
+  statistics->RecordConversionFailure();
+  statistics->RecordNotify();
+  statistics->SetConnected(true);
+  auto snapshot = statistics->GetSnapshot();
+  EXPECT_EQ(snapshot.updates_received, 0);
+  EXPECT_EQ(snapshot.conversion_failures, 0);
+  EXPECT_EQ(snapshot.notify_count, 0);
+  EXPECT_EQ(snapshot.bytes_received, 0);
+  EXPECT_LT(snapshot.last_update_age, 0.0);
+  // The connection state is still tracked for the diagnostics
+  EXPECT_TRUE(snapshot.connected);
+  EXPECT_TRUE(IsRegistered(statistics.get()));
+
+  // Statistics created after enabling count again
+  auto enabled = epics_helper::CreateVariableStatistics("TestVariable", "test::enabled");
+  enabled->RecordUpdate(8);
+  EXPECT_EQ(enabled->GetSnapshot().updates_received, 1);
+}
+
+TEST_F(VariableStatisticsTest, Registry)
+{
+  auto statistics = epics_helper::CreateVariableStatistics("TestVariable", "test::registry");
+  EXPECT_TRUE(IsRegistered(statistics.get()));
+  {
+    auto other = epics_helper::CreateVariableStatistics("TestVariable", "test::other");
+    EXPECT_TRUE(IsRegistered(other.get()));
+    EXPECT_TRUE(IsRegistered(statistics.get()));
+  }
+  // Statistics that are no longer owned by a variable are not listed
+  auto all_statistics = epics_helper::GetVariableStatistics();
+  auto has_other = std::any_of(all_statistics.begin(), all_statistics.end(),
+                               [](const StatisticsPtr& entry) {
+                                 return entry->GetChannel() == "test::other";
+                               });
+  EXPECT_FALSE(has_other);
+  auto statistics_ptr = statistics.get();
+  statistics.reset();
+  EXPECT_FALSE(IsRegistered(statistics_ptr));
+}
+
+TEST_F(VariableStatisticsTest, FixedPayloadSize)
+{
+  EXPECT_EQ(epics_helper::FixedPayloadSize(sup::dto::EmptyType), 0);
+  EXPECT_EQ(epics_helper::FixedPayloadSize(sup::dto::BooleanType), 1);
+  EXPECT_EQ(epics_helper::FixedPayloadSize(sup::dto::UnsignedInteger16Type), 2);
+  EXPECT_EQ(epics_helper::FixedPayloadSize(sup::dto::Float64Type), 8);
+  EXPECT_EQ(epics_helper::FixedPayloadSize(sup::dto::StringType), 0);
+
+  sup::dto::AnyType array_type{16, sup::dto::Float32Type};
+  EXPECT_EQ(epics_helper::FixedPayloadSize(array_type), 64);
+
+  sup::dto::AnyType struct_type{{
+    {"value", sup::dto::Float64Type},
+    {"severity", sup::dto::SignedInteger16Type}
+  }};
+  EXPECT_EQ(epics_helper::FixedPayloadSize(struct_type), 10);
+
+  // Variable size members make the whole size unknown
+  sup::dto::AnyType with_string{{
+    {"value", sup::dto::Float64Type},
+    {"units", sup::dto::StringType}
+  }};
+  EXPECT_EQ(epics_helper::FixedPayloadSize(with_string), 0);
+}
+
+VariableStatisticsTest::VariableStatisticsTest() = default;
+
+VariableStatisticsTest::~VariableStatisticsTest() = default;
+
+bool VariableStatisticsTest::IsRegistered(const epics_helper::VariableStatistics* statistics)
+{
+  auto all_statistics = epics_helper::GetVariableStatistics();
+  return std::any_of(all_statistics.begin(), all_statistics.end(),
+                     [statistics](const StatisticsPtr& entry) {
+                       return entry.get() == statistics;
+                     });
+}
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP oac-tree
+ *
+ * Description   : Unit test code
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+#include <oac-tree/common/wakeup_signal.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace sup::oac_tree;
+
+class WakeupSignalTest : public ::testing::Test
+{
+protected:
+  WakeupSignalTest();
+  ~WakeupSignalTest();
+
+  static sup::dto::uint64 Now();
+};
+
+TEST_F(WakeupSignalTest, Timeout)
+{
+  epics_helper::WakeupSignal signal;
+  auto count = signal.GetCount();
+  // Deadline in the past
+  EXPECT_FALSE(signal.WaitForSignal(count, 0));
+  // Wait is bounded by the deadline
+  auto start = Now();
+  EXPECT_FALSE(signal.WaitForSignal(count, start + 5000000));
+  EXPECT_GE(Now() - start, 5000000);
+  // Wait is bounded by the maximum wait time
+  start = Now();
+  EXPECT_FALSE(signal.WaitForSignal(count, start + 100 * epics_helper::MAX_WAKEUP_WAIT_NS));
+  EXPECT_LT(Now() - start, 10 * epics_helper::MAX_WAKEUP_WAIT_NS);
+}
+
+TEST_F(WakeupSignalTest, SignalIsNotLost)
+{
+  epics_helper::WakeupSignal signal;
+  auto count = signal.GetCount();
+  signal.Signal();
+  EXPECT_EQ(signal.GetCount(), count + 1);
+  // Signal raised before the wait returns immediately
+  EXPECT_TRUE(signal.WaitForSignal(count, Now() + 10 * epics_helper::MAX_WAKEUP_WAIT_NS));
+}
+
+TEST_F(WakeupSignalTest, SignalFromOtherThread)
+{
+  epics_helper::WakeupSignal signal;
+  auto count = signal.GetCount();
+  std::thread signaller([&signal]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    signal.Signal();
+  });
+  EXPECT_TRUE(signal.WaitForSignal(count, Now() + 10 * epics_helper::MAX_WAKEUP_WAIT_NS));
+  signaller.join();
+}
+
+WakeupSignalTest::WakeupSignalTest() = default;
+WakeupSignalTest::~WakeupSignalTest() = default;
+
+sup::dto::uint64 WakeupSignalTest::Now()
+{
+  auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+}